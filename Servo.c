@@ -1,79 +1,113 @@
-#include <msp430.h>
-
-// Servo Configuration (for 16MHz SMCLK with /8 divider)
-#define SERVO_PIN         BIT0       // P2.0 (TB1.1)
-#define PWM_PERIOD        40000      // 20ms period (16MHz/8 = 2MHz → 2000000Hz → 40000 ticks = 20ms)
-#define MIN_PULSE_WIDTH   1000       // 500μs pulse (1000 ticks at 2MHz)
-#define MAX_PULSE_WIDTH   2000       // 1000μs pulse (2000 ticks at 2MHz)
-#define NEUTRAL_POSITION  1500       // 750μs pulse (1500 ticks)
-
-// Function Prototypes
-void Servo_Init(void);
-void Servo_SetPosition(unsigned int position);
-void Servo_Calibrate(unsigned int min, unsigned int max);
-
-int main(void) {
-    WDTCTL = WDTPW | WDTHOLD;        // Stop watchdog timer
-    PM5CTL0 &= ~LOCKLPM5;            // Unlock GPIOs
-    
-    Servo_Init();                    // Initialize servo control
-    
-    // Example usage:
-    while(1) {
-        Servo_SetPosition(NEUTRAL_POSITION);  // 750μs pulse
-        __delay_cycles(1000000);     // Hold for 1s
-        
-        Servo_SetPosition(MIN_PULSE_WIDTH);   // 500μs pulse
-        __delay_cycles(1000000);
-        
-        Servo_SetPosition(MAX_PULSE_WIDTH);   // 1000μs pulse
-        __delay_cycles(1000000);
-    }
-}
-
-// Initialize servo PWM on P2.0
-void Servo_Init(void) {
-    // Configure P2.0 for TB1.1 output
-    P2DIR |= SERVO_PIN;
-    P2SEL0 |= SERVO_PIN;             // Select TB1.1 function
-    P2SEL1 &= ~SERVO_PIN;
-    
-    // Timer_B1 configuration (Servo control)
-    TB1CCR0 = PWM_PERIOD;            // 20ms period
-    TB1CCTL1 = OUTMOD_7;             // Reset/set output mode
-    TB1CCR1 = NEUTRAL_POSITION;      // Start at neutral position
-    TB1CTL = TBSSEL__SMCLK | ID__8 | MC__UP | TBCLR; // SMCLK/8, up mode
-}
-
-// Set servo pulse width in microseconds (500-1000μs)
-void Servo_SetPosition(unsigned int pulse_us) {
-    // Convert microseconds to timer ticks (2MHz clock → 2 ticks/μs)
-    unsigned int position = pulse_us * 2;
-    
-    // Constrain position to valid range
-    if(position < MIN_PULSE_WIDTH) position = MIN_PULSE_WIDTH;
-    if(position > MAX_PULSE_WIDTH) position = MAX_PULSE_WIDTH;
-    
-    TB1CCR1 = position;  // Update PWM pulse width
-}
-
-// Calibrate servo limits in microseconds
-void Servo_Calibrate(unsigned int min_us, unsigned int max_us) {
-    // Convert to timer ticks
-    unsigned int min_ticks = min_us * 2;
-    unsigned int max_ticks = max_us * 2;
-    
-    // Update min/max pulse widths
-    #undef MIN_PULSE_WIDTH
-    #undef MAX_PULSE_WIDTH
-    #define MIN_PULSE_WIDTH min_ticks
-    #define MAX_PULSE_WIDTH max_ticks
-    
-    // Safety check
-    if(MIN_PULSE_WIDTH >= MAX_PULSE_WIDTH) {
-        #undef MIN_PULSE_WIDTH
-        #undef MAX_PULSE_WIDTH
-        #define MIN_PULSE_WIDTH 1000  // Default 500μs
-        #define MAX_PULSE_WIDTH 2000  // Default 1000μs
-    }
-}
\ No newline at end of file
+#include <msp430.h>
+#include "servo.h"
+#include "fixmath.h"
+
+// Runtime limits in timer ticks (set by Servo_Calibrate)
+static unsigned int minTicks = MIN_PULSE_WIDTH;
+static unsigned int maxTicks = MAX_PULSE_WIDTH;
+
+// Active motion profile, owned by the Timer_B1 CCR0 ISR while moving
+static volatile uint8_t moving = 0;
+static unsigned int startTicks;
+static int16_t deltaTicks;
+static uint16_t phase;               // 0..65535 over the move (Q16)
+static uint16_t phaseStep;           // Phase advance per PWM period
+static uint16_t periodsLeft;         // Interrupts until the move lands
+static ServoCallback moveDone;
+
+// Initialize servo PWM on P2.0
+void Servo_Init(void) {
+    // Configure P2.0 for TB1.1 output
+    P2DIR |= SERVO_PIN;
+    P2SEL0 |= SERVO_PIN;             // Select TB1.1 function
+    P2SEL1 &= ~SERVO_PIN;
+    
+    // Timer_B1 configuration (Servo control)
+    TB1CCR0 = PWM_PERIOD;            // 20ms period
+    TB1CCTL1 = OUTMOD_7 | CLLD_1;    // Reset/set output mode, latch new width at period start
+    TB1CCR1 = NEUTRAL_POSITION;      // Start at neutral position
+    TB1CTL = TBSSEL__SMCLK | ID__8 | MC__UP | TBCLR; // SMCLK/8, up mode
+}
+
+static unsigned int ClampTicks(unsigned int ticks) {
+    if(ticks < minTicks) ticks = minTicks;
+    if(ticks > maxTicks) ticks = maxTicks;
+    return ticks;
+}
+
+// Set servo pulse width in microseconds (500-1000μs)
+void Servo_SetPosition(unsigned int pulse_us) {
+    Servo_Stop();
+    
+    // Convert microseconds to timer ticks (2MHz clock → 2 ticks/μs)
+    TB1CCR1 = ClampTicks(pulse_us * 2);  // Update PWM pulse width
+}
+
+// Calibrate servo limits in microseconds
+uint8_t Servo_Calibrate(unsigned int min_us, unsigned int max_us) {
+    // Convert to timer ticks
+    unsigned int min_ticks = min_us * 2;
+    unsigned int max_ticks = max_us * 2;
+    
+    // Safety check: reject inverted limits or pulses longer than the period
+    if(min_ticks >= max_ticks || max_ticks >= PWM_PERIOD) return 0;
+    
+    Servo_Stop();
+    minTicks = min_ticks;
+    maxTicks = max_ticks;
+    TB1CCR1 = ClampTicks(TB1CCR1);
+    return 1;
+}
+
+// Start a non-blocking move to pulse_us over time_ms. The profile is
+// advanced by the Timer_B1 CCR0 interrupt; 'done' runs in ISR context,
+// then the ISR wakes the CPU from LPM0.
+uint8_t Servo_MoveTo(unsigned int pulse_us, unsigned int time_ms, ServoCallback done) {
+    unsigned int target = ClampTicks(pulse_us * 2);
+    unsigned int periods = time_ms / PWM_PERIOD_MS;
+    
+    Servo_Stop();
+    
+    // Even an instant move completes from the ISR, so 'done' always runs
+    // in the same context
+    if (periods == 0) periods = 1;
+    
+    // One interrupt per period, the last one landing on target: a move
+    // takes exactly 'periods' PWM periods
+    startTicks = TB1CCR1;
+    deltaTicks = (int16_t)(target - startTicks);
+    phase = 0;
+    phaseStep = (uint16_t)(0x10000UL / periods);    // Unused when periods == 1
+    periodsLeft = periods;
+    moveDone = done;
+    
+    moving = 1;
+    TB1CCTL0 = CCIE;                 // One interrupt per PWM period
+    return 1;
+}
+
+uint8_t Servo_Busy(void) {
+    return moving;
+}
+
+void Servo_Stop(void) {
+    TB1CCTL0 &= ~CCIE;
+    moving = 0;
+}
+
+// Timer_B1 CCR0: one profile step per PWM period
+#pragma vector=TIMER1_B0_VECTOR
+__interrupt void Timer1_B0_ISR(void) {
+    if (--periodsLeft == 0) {
+        // Final step: land exactly on target and stop interrupting
+        TB1CCR1 = startTicks + deltaTicks;
+        TB1CCTL0 &= ~CCIE;
+        moving = 0;
+        if (moveDone) moveDone();
+        __bic_SR_register_on_exit(LPM0_bits);   // Caller may sleep until the move ends
+        return;
+    }
+    phase += phaseStep;
+    
+    TB1CCR1 = startTicks + (int16_t)(FX_MulS16(deltaTicks, FX_EaseQ15(phase)) >> 15);
+}
@@ -0,0 +1,125 @@
+#include "acquire.h"
+#include "metrics.h"
+#include "ramfunc.h"
+#include <msp430.h>
+
+volatile uint8_t acquireRunning = 0;
+
+static AcquireBlock blocks[2];
+static uint8_t filling = 0;                // Block the ISR writes
+static uint8_t published = 0;              // Block handed to the main loop
+static volatile uint8_t ready = 0;
+static uint8_t handover = ACQUIRE_BLOCK;   // Samples that make a block
+static uint8_t channel = 0;
+
+static uint16_t lastSample = 0;
+static uint8_t sampled = 0;
+
+static void Configure(void) {
+    ADCCTL0 &= ~ADCENC;                    // Control bits are locked while set
+    ADCCTL0 |= ADCON;
+    ADCCTL1 = ADCSHS_2 | ADCSHP | ADCCONSEQ_2;   // TB1.1B, repeat single channel
+    ADCMCTL0 = (ADCMCTL0 & ~ADCINCH_15) | channel;
+    ADCIFG &= ~ADCIFG0;
+    ADCIE = ADCIE0;
+    acquireRunning = 1;
+    ADCCTL0 |= ADCENC;                     // Converts on each trigger edge from here
+}
+
+static void Halt(void) {
+    acquireRunning = 0;
+    ADCCTL0 &= ~ADCENC;                    // Stops after a conversion in flight
+    while (ADCCTL1 & ADCBUSY);
+    ADCCTL1 = ADCSHP;                      // Back to ADCSC, single conversion
+}
+
+void Acquire_Start(uint8_t adcChannel) {
+    channel = adcChannel;
+    blocks[0].count = 0;
+    blocks[1].count = 0;
+    filling = 0;
+    ready = 0;
+    handover = ACQUIRE_BLOCK;
+    sampled = 0;
+    Configure();
+}
+
+void Acquire_Stop(void) {
+    if (!acquireRunning) return;
+    Halt();
+}
+
+const AcquireBlock *Acquire_Take(void) {
+    return ready ? &blocks[published] : 0;
+}
+
+// Samples that arrived while the main loop held the last block are
+// handed over at once if there are enough of them
+void Acquire_Release(uint8_t lit) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    handover = lit ? 1 : ACQUIRE_BLOCK;
+    if (blocks[filling].count >= handover) {
+        published = filling;
+        filling ^= 1;
+        blocks[filling].count = 0;
+    } else {
+        ready = 0;
+    }
+    __set_interrupt_state(gie);
+}
+
+// Software conversions (pot, thermistor) share the ADC; a trigger edge
+// that lands while paused is lost and shows up in METRIC_ACQ_MISSED
+uint8_t Acquire_Pause(void) {
+    if (!acquireRunning) return 0;
+    Halt();
+    return 1;
+}
+
+void Acquire_Resume(void) {
+    Configure();
+}
+
+// Sample spacing against the PWM period. Stamped when the result is
+// handled, so for the timer path this is ISR latency on top of exact
+// conversion timing; for the software path it is the loop's timing.
+RAMFUNC void Acquire_ObserveInterval(uint16_t now) {
+    uint16_t interval = now - lastSample;
+    
+    if (sampled) {
+        if (interval > ACQUIRE_PERIOD_TICKS + ACQUIRE_PERIOD_TICKS / 2) {
+            Metrics_Count(METRIC_ACQ_MISSED);
+        } else {
+            Metrics_Observe(METRIC_FLAME_JITTER, (interval > ACQUIRE_PERIOD_TICKS) ?
+                            interval - ACQUIRE_PERIOD_TICKS : ACQUIRE_PERIOD_TICKS - interval);
+        }
+    }
+    lastSample = now;
+    sampled = 1;
+}
+
+RAMFUNC uint8_t Acquire_Store(uint16_t sample) {
+    uint16_t start = METRICS_NOW();
+    AcquireBlock *block = &blocks[filling];
+    uint8_t wake = 0;
+    
+    Acquire_ObserveInterval(start);
+    block->samples[block->count++] = sample;
+    
+    if (block->count >= handover && !ready) {
+        published = filling;
+        filling ^= 1;
+        blocks[filling].count = 0;
+        ready = 1;
+        wake = 1;
+    } else if (block->count >= ACQUIRE_BLOCK) {
+        // Main loop still holds the other block and this one is full:
+        // drop it
+        Metrics_Add(METRIC_ACQ_MISSED, block->count);
+        block->count = 0;
+    }
+    
+    Metrics_Observe(METRIC_ACQ_SAMPLE_COST, METRICS_NOW() - start);
+    return wake;
+}
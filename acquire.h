@@ -0,0 +1,40 @@
+#ifndef ACQUIRE_H_
+#define ACQUIRE_H_
+
+#include <stdint.h>
+#include "main_valve.h"
+
+// Timer-triggered flame acquisition. ADCSHS_2 selects TB1.1B, the
+// Timer_B1 CCR1 output (FR2355 datasheet, ADC trigger signal
+// connections: 0 = ADCSC, 1 = TB0.1B, 2 = TB1.1B, 3 = TB2.1B). That is
+// the main valve PWM itself (reset/set, up mode), so the ADC converts on
+// the rising edge at the start of every valve pulse: samples are exactly
+// one PWM period apart and always at the same point in it. The pulse
+// never drops below MAIN_VALVE_MIN_FLOW, so the edge is there with the
+// valve closed too.
+//
+// The ADC ISR stores results and wakes the CPU for a full block. While
+// the flame is lit each sample is handed over as soon as the main loop
+// has taken the last one, so flame loss is seen no later than with one
+// software conversion per pass.
+#define ACQUIRE_PERIOD_TICKS  (MAIN_VALVE_PWM_PERIOD / 8)   // In Timer_B2 (SMCLK/8) ticks
+#define ACQUIRE_BLOCK         8         // Samples per wakeup while unlit (160ms)
+
+typedef struct {
+    uint8_t count;
+    uint16_t samples[ACQUIRE_BLOCK];
+} AcquireBlock;
+
+extern volatile uint8_t acquireRunning;
+
+// Function Prototypes
+void Acquire_Start(uint8_t channel);
+void Acquire_Stop(void);
+const AcquireBlock *Acquire_Take(void);         // Published block, or 0
+void Acquire_Release(uint8_t lit);              // Done with it; lit = hand over every sample
+uint8_t Acquire_Pause(void);                    // Around software conversions,
+void Acquire_Resume(void);                      // resume only if Pause returned 1
+void Acquire_ObserveInterval(uint16_t now);     // Flame sample spacing, either path
+uint8_t Acquire_Store(uint16_t sample);         // From the ADC ISR, 1 = wake main
+
+#endif
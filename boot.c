@@ -0,0 +1,85 @@
+#include "boot.h"
+#include "fram.h"
+#include <msp430.h>
+
+#define BOOT_MAGIC        0xB007
+#define BOOT_TIMER_SHIFT  3          // Timer_B2 runs at SMCLK/8
+
+#pragma PERSISTENT(bootRecord)
+BootRecord bootRecord = { 0 };
+
+volatile uint16_t bootTimeUs = 0;
+
+static BootRecord record;            // Working copy for this boot
+static uint8_t firstSampleSeen = 0;
+
+static void SaveRecord(void) {
+    record.checksum = FRAM_Checksum(&record, sizeof(record) - sizeof(record.checksum));
+    FRAM_Write(&bootRecord, &record, sizeof(record));
+}
+
+// Runs from the C startup code before .data/.bss initialization
+int _system_pre_init(void) {
+    WDTCTL = WDTPW | WDTHOLD;        // Stop watchdog timer
+    
+    // Free-running Timer_B2 from reset for boot timing (8µs per tick)
+    TB2CTL = TBSSEL__SMCLK | ID__8 | MC__CONTINUOUS | TBCLR;
+    
+    return 1;                        // Run the normal C variable init
+}
+
+uint8_t Boot_FastPathValid(void) {
+    uint8_t valid;
+    
+    record = bootRecord;
+    valid = (record.magic == BOOT_MAGIC) &&
+            (record.checksum == FRAM_Checksum(&record, sizeof(record) - sizeof(record.checksum))) &&
+            (record.imageVersion == BOOT_IMAGE_VERSION) &&
+            record.complete;
+    
+    if (!valid) {
+        record.magic = BOOT_MAGIC;
+        record.imageVersion = 0;
+        record.resets = 0;
+        record.brownouts = 0;
+        record.bootTimeUs = 0;
+    }
+    
+    record.resetCause = SYSRSTIV;
+    record.resets++;
+    if (record.resetCause == SYSRSTIV_BOR || record.resetCause == SYSRSTIV_SVSHIFG) {
+        record.brownouts++;
+    }
+    
+    // A boot that never reaches its first flame sample falls back to
+    // the full init path next time
+    record.fastBoot = valid;
+    record.complete = 0;
+    SaveRecord();
+    
+    return valid;
+}
+
+void Boot_ApplyImage(const RegImage *image, uint16_t count) {
+    while (count--) {
+        *image->reg = image->value;
+        image++;
+    }
+}
+
+void Boot_FullInitDone(void) {
+    record.imageVersion = BOOT_IMAGE_VERSION;
+}
+
+void Boot_FirstFlameSample(void) {
+    if (firstSampleSeen) return;
+    firstSampleSeen = 1;
+    
+    uint16_t ticks = TB2R;
+    bootTimeUs = (ticks > (0xFFFF >> BOOT_TIMER_SHIFT)) ? 0xFFFF : ticks << BOOT_TIMER_SHIFT;
+    // Timer_B2 keeps running as the metrics timebase (metrics.h)
+    
+    record.bootTimeUs = bootTimeUs;
+    record.complete = 1;
+    SaveRecord();
+}
@@ -0,0 +1,38 @@
+#ifndef BOOT_H_
+#define BOOT_H_
+
+#include <stdint.h>
+
+// Bump whenever the peripheral setup changes so the first boot after a
+// reflash takes the full init path
+#define BOOT_IMAGE_VERSION   6
+
+// One register write of a precomputed peripheral image
+typedef struct {
+    volatile uint16_t *reg;
+    uint16_t value;
+} RegImage;
+
+// Boot record, kept in FRAM across resets
+typedef struct {
+    uint16_t magic;
+    uint16_t imageVersion;     // Version of the last completed full init
+    uint16_t complete;         // 1 once the last boot reached its first flame sample
+    uint16_t resets;
+    uint16_t brownouts;
+    uint16_t resetCause;       // SYSRSTIV of the last reset
+    uint16_t fastBoot;         // 1 if the last boot used the fast path
+    uint16_t bootTimeUs;       // Reset to first flame sample (µs, 8µs resolution)
+    uint16_t checksum;
+} BootRecord;
+
+extern BootRecord bootRecord;
+extern volatile uint16_t bootTimeUs;    // This boot, for the debugger
+
+// Function Prototypes
+uint8_t Boot_FastPathValid(void);
+void Boot_ApplyImage(const RegImage *image, uint16_t count);
+void Boot_FullInitDone(void);
+void Boot_FirstFlameSample(void);
+
+#endif
@@ -0,0 +1,66 @@
+#include "demand.h"
+#include "system_state.h"
+#include "metrics.h"
+
+DemandConfig demandConfig = {
+    DEMAND_MIN_BURN_MS, DEMAND_MIN_OFF_MS, DEMAND_MERGE_MS, DEMAND_PILOT_HOLD_MS
+};
+
+static uint32_t burnMs = 0;                // Main valve open, this burn
+static uint32_t offMs = 0xFFFFFFFFUL;      // Idle since the last cycle; none yet
+static uint32_t gapMs = 0xFFFFFFFFUL;      // Since the raw request last dropped
+static uint8_t bridging = 0;               // Burning on through a request gap
+
+static uint32_t AddSat(uint32_t a, uint16_t b) {
+    return (a + b < a) ? 0xFFFFFFFFUL : a + b;
+}
+
+// Called once per pass with the raw request (pin, thermostat or bus).
+// Returns whether the burner should be, or stay, lit. Flame loss and
+// the safety switch act on the state machine directly and are never
+// held off by this.
+uint8_t Demand_Update(uint8_t request, uint8_t state, uint16_t elapsedMs) {
+    uint8_t demand;
+    
+    gapMs = request ? 0 : AddSat(gapMs, elapsedMs);
+    
+    switch (state) {
+        case STATE_MAIN_VALVE:
+            burnMs = AddSat(burnMs, elapsedMs);
+            
+            // Never cut a burn short, and ride through short gaps
+            demand = request || gapMs < demandConfig.mergeMs ||
+                     burnMs < demandConfig.minBurnMs;
+            if (!request && demand) {
+                bridging = 1;
+            } else if (request && bridging) {
+                bridging = 0;
+                Metrics_Count(METRIC_DEMAND_MERGED);
+            }
+            break;
+            
+        case STATE_IDLE:
+            // Requests arriving too soon after the last cycle wait, so a
+            // burst of them becomes one ignition
+            offMs = AddSat(offMs, elapsedMs);
+            demand = request && offMs >= demandConfig.minOffMs;
+            break;
+            
+        case STATE_PILOT_HOLD:
+            // Pilot still lit, relighting the main burner costs nothing
+            offMs = AddSat(offMs, elapsedMs);
+            demand = request;
+            break;
+            
+        default:
+            offMs = 0;
+            demand = request;
+            break;
+    }
+    
+    if (state != STATE_MAIN_VALVE) {
+        burnMs = 0;
+        bridging = 0;
+    }
+    return demand;
+}
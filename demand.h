@@ -0,0 +1,26 @@
+#ifndef DEMAND_H_
+#define DEMAND_H_
+
+#include <stdint.h>
+
+// Demand shaping in front of the burner state machine. Every ignition
+// costs a prepurge, spark and prove, so brief requests and short gaps
+// are absorbed here instead of each becoming a full cycle.
+#define DEMAND_MIN_BURN_MS    120000UL  // Main valve stays open at least this long
+#define DEMAND_MIN_OFF_MS     180000UL  // Idle time before the next ignition
+#define DEMAND_MERGE_MS       30000UL   // Request gaps shorter than this are bridged
+#define DEMAND_PILOT_HOLD_MS  0         // Pilot stays lit after a burn (ms), 0 = off
+
+typedef struct {
+    uint32_t minBurnMs;
+    uint32_t minOffMs;
+    uint32_t mergeMs;
+    uint16_t pilotHoldMs;     // Timed by the 16-bit state timer
+} DemandConfig;
+
+extern DemandConfig demandConfig;
+
+// Function Prototypes
+uint8_t Demand_Update(uint8_t request, uint8_t state, uint16_t elapsedMs);
+
+#endif
@@ -0,0 +1,28 @@
+#include <msp430.h>
+#include "pilot_valve.h"
+
+// Pilot valve driver on its own: P5.0 high opens the valve, P1.1 low or
+// P1.2 high forces it closed.
+
+void main(void) {
+    WDTCTL = WDTPW | WDTHOLD;     // Stop watchdog timer
+    PM5CTL0 &= ~LOCKLPM5;         // Disable GPIO power-on default
+    
+    // Configure input pins
+    P5DIR &= ~BIT0;    // P5.0 as input (thermostat)
+    P1DIR &= ~(BIT1 | BIT2);  // P1.1 and P1.2 as inputs
+    
+    Pilot_Init();                 // Initialize pilot valve control
+    
+    while(1) {
+        // Control logic
+        if (P5IN & BIT0) {        // If thermostat calls for heat
+            Heat_On();            // Open valve if not already open
+        }
+        else if (!(P1IN & BIT1) || (P1IN & BIT2)) {  // Emergency stop conditions
+            Pilot_Close();        // Force close valve
+        }
+        
+        __delay_cycles(100000);   // 100ms delay
+    }
+}
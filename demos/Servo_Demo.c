@@ -0,0 +1,36 @@
+#include <msp430.h>
+#include "servo.h"
+
+// Servo driver on its own: sweeps P2.0 between three positions, one
+// second per move, sleeping in LPM0 while the Timer_B1 ISR runs the
+// S-curve profile.
+
+static volatile uint8_t demoDone = 0;
+
+// Runs in the Timer_B1 ISR, which wakes main once it returns
+static void DemoMoveDone(void) {
+    demoDone = 1;
+}
+
+int main(void) {
+    WDTCTL = WDTPW | WDTHOLD;        // Stop watchdog timer
+    PM5CTL0 &= ~LOCKLPM5;            // Unlock GPIOs
+    
+    Servo_Init();                    // Initialize servo control
+    __enable_interrupt();
+    
+    // Example usage: each move takes 1s and the CPU sleeps meanwhile
+    while(1) {
+        Servo_MoveTo(NEUTRAL_POSITION / 2, 1000, DemoMoveDone);  // 750μs pulse
+        while (!demoDone) __bis_SR_register(LPM0_bits | GIE);
+        demoDone = 0;
+        
+        Servo_MoveTo(MIN_PULSE_WIDTH / 2, 1000, DemoMoveDone);   // 500μs pulse
+        while (!demoDone) __bis_SR_register(LPM0_bits | GIE);
+        demoDone = 0;
+        
+        Servo_MoveTo(MAX_PULSE_WIDTH / 2, 1000, DemoMoveDone);   // 1000μs pulse
+        while (!demoDone) __bis_SR_register(LPM0_bits | GIE);
+        demoDone = 0;
+    }
+}
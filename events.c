@@ -0,0 +1,26 @@
+#include "events.h"
+#include "ramfunc.h"
+
+SPSC_QUEUE_DEFINE(eventQueue, Event, EVENT_QUEUE_SIZE);
+SPSC_QUEUE_DEFINE(adcQueue, Event, ADC_QUEUE_SIZE);
+
+volatile uint16_t eventsDropped = 0;
+
+// Called from ISR context only
+RAMFUNC uint8_t Event_Post(SpscQueue *q, uint8_t type, uint8_t arg8, uint16_t arg16) {
+    Event event;
+    event.type = type;
+    event.arg8 = arg8;
+    event.arg16 = arg16;
+
+    if (!Queue_Push(q, &event)) {
+        eventsDropped++;           // Queue full, count the overflow
+        return 0;
+    }
+    return 1;
+}
+
+// Called from the main loop only
+uint8_t Event_Get(SpscQueue *q, Event *event) {
+    return Queue_Pop(q, event);
+}
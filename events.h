@@ -0,0 +1,37 @@
+#ifndef EVENTS_H_
+#define EVENTS_H_
+
+#include <stdint.h>
+#include "spsc_queue.h"
+
+// Event types posted from ISRs
+typedef enum {
+    EVENT_NONE,
+    EVENT_ADC_RESULT,      // arg8 = channel, arg16 = ADCMEM0
+    EVENT_HEAT_REQUEST,    // arg8 = 1 requested, 0 released
+    EVENT_SAFETY_SWITCH,   // arg8 = 1 tripped, 0 released
+    EVENT_THERMOSTAT_FRAME // arg8 = flags, arg16 = setpoint | modulation << 8
+} EventType;
+
+// Fixed-size 4-byte event
+typedef struct {
+    uint8_t type;
+    uint8_t arg8;
+    uint16_t arg16;
+} Event;
+
+// Queue sizes (must be powers of two)
+#define EVENT_QUEUE_SIZE   16
+#define ADC_QUEUE_SIZE     4
+
+// ISRs do not nest, so all ISRs together form the single producer of
+// each queue and the main loop is the single consumer.
+extern SpscQueue eventQueue;       // GPIO events for the main loop
+extern SpscQueue adcQueue;         // Conversion results for readADC()
+extern volatile uint16_t eventsDropped;
+
+// Function Prototypes
+uint8_t Event_Post(SpscQueue *q, uint8_t type, uint8_t arg8, uint16_t arg16);
+uint8_t Event_Get(SpscQueue *q, Event *event);
+
+#endif
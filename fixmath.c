@@ -0,0 +1,143 @@
+#include "fixmath.h"
+#include <msp430.h>
+
+// log2(1 + i/16) in Q16.16, i = 0..16
+static const uint16_t log2Table[17] = {
+        0,  5732, 11136, 16248, 21098, 25711, 30109, 34312, 38336,
+    42196, 45904, 49472, 52911, 56229, 59434, 62534, 65535
+};
+
+// Raised cosine (1 - cos(pi t)) / 2 in Q15, t = i/16, i = 0..16: zero
+// slope at both ends so actuators start and stop without a current spike
+static const int16_t easeTable[17] = {
+        0,   315,  1247,  2761,  4799,  7281, 10114, 13187, 16383,
+    19580, 22653, 25486, 27968, 30006, 31520, 32452, 32767
+};
+
+#if defined(__MSP430_HAS_MPY32__)
+
+// The multiplier is shared with ISRs, so each operation runs with
+// interrupts held off for the few cycles it takes.
+
+uint32_t FX_MulU16(uint16_t a, uint16_t b) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    MPY = a;
+    OP2 = b;
+    uint32_t result = ((uint32_t)RESHI << 16) | RESLO;
+    __set_interrupt_state(gie);
+    return result;
+}
+
+int32_t FX_MulS16(int16_t a, int16_t b) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    MPYS = (uint16_t)a;
+    OP2 = (uint16_t)b;
+    int32_t result = (int32_t)(((uint32_t)RESHI << 16) | RESLO);
+    __set_interrupt_state(gie);
+    return result;
+}
+
+uint16_t FX_MulQ24(uint16_t x, uint32_t k) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    MPY32L = (uint16_t)k;
+    MPY32H = (uint16_t)(k >> 16);
+    OP2L = x;
+    OP2H = 0;
+    uint16_t r1 = RES1;
+    uint16_t r2 = RES2;
+    uint16_t r3 = RES3;
+    __set_interrupt_state(gie);
+
+    if ((r2 >> 8) | r3) return 0xFFFF;   // Result exceeds 16 bits
+    return (uint16_t)((r2 << 8) | (r1 >> 8));
+}
+
+int32_t FX_MulHiS32(int32_t a, int32_t b) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    MPYS32L = (uint16_t)a;
+    MPYS32H = (uint16_t)((uint32_t)a >> 16);
+    OP2L = (uint16_t)b;
+    OP2H = (uint16_t)((uint32_t)b >> 16);
+    int32_t result = (int32_t)(((uint32_t)RES3 << 16) | RES2);
+    __set_interrupt_state(gie);
+    return result;
+}
+
+#else
+
+uint32_t FX_MulU16(uint16_t a, uint16_t b) {
+    return (uint32_t)a * b;
+}
+
+int32_t FX_MulS16(int16_t a, int16_t b) {
+    return (int32_t)a * b;
+}
+
+uint16_t FX_MulQ24(uint16_t x, uint32_t k) {
+    uint64_t product = ((uint64_t)x * k) >> 24;
+    return (product > 0xFFFF) ? 0xFFFF : (uint16_t)product;
+}
+
+int32_t FX_MulHiS32(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b) >> 32);
+}
+
+#endif
+
+uint16_t FX_SatAddU16(uint16_t a, uint16_t b) {
+    uint16_t sum = a + b;
+    return (sum < a) ? 0xFFFF : sum;
+}
+
+uint16_t FX_SatSubU16(uint16_t a, uint16_t b) {
+    return (a > b) ? (uint16_t)(a - b) : 0;
+}
+
+int16_t FX_SatAddS16(int16_t a, int16_t b) {
+    return FX_SatS16((int32_t)a + b);
+}
+
+uint16_t FX_SatU16(int32_t x) {
+    if (x < 0) return 0;
+    if (x > 0xFFFF) return 0xFFFF;
+    return (uint16_t)x;
+}
+
+int16_t FX_SatS16(int32_t x) {
+    if (x < -32768L) return -32768;
+    if (x > 32767L) return 32767;
+    return (int16_t)x;
+}
+
+int32_t FX_Log2Q16(uint32_t x) {
+    int16_t exponent = 31;
+
+    if (x == 0) return -(32L << 16);     // Treat log2(0) as very negative
+
+    // Normalize so the leading one sits in bit 31
+    while (!(x & 0x80000000UL)) {
+        x <<= 1;
+        exponent--;
+    }
+
+    // Mantissa fraction in Q16, then interpolate the 16-segment table
+    uint16_t frac = (uint16_t)(x >> 15);
+    uint8_t idx = frac >> 12;
+    uint16_t rem = frac & 0x0FFF;
+    uint16_t lo = log2Table[idx];
+    uint16_t span = log2Table[idx + 1] - lo;
+
+    return ((int32_t)exponent << 16) + lo + (uint16_t)(FX_MulU16(span, rem) >> 12);
+}
+
+int16_t FX_EaseQ15(uint16_t phase) {
+    // Top 4 bits pick the segment, the next 12 interpolate it
+    uint8_t seg = phase >> 12;
+    int16_t lo = easeTable[seg];
+
+    return lo + (int16_t)(FX_MulS16(easeTable[seg + 1] - lo, phase & 0x0FFF) >> 12);
+}
@@ -0,0 +1,36 @@
+#ifndef FIXMATH_H_
+#define FIXMATH_H_
+
+#include <stdint.h>
+
+// Fixed-point helpers for sensor and actuator scaling.
+// Uses the FR2355 MPY32 hardware multiplier when the device has one,
+// otherwise falls back to portable C.
+
+// Compile-time Q8.24 reciprocal constant for x * num / den.
+// Rounded up so FX_MulQ24() gives the same result as integer division
+// for every 12-bit input (exact floor while x * num < 2^24 / den).
+#define FX_Q24(num, den)   ((uint32_t)((((uint64_t)(num) << 24) + (den) - 1) / (den)))
+
+// Q16.16 constant from a rational (rounded to nearest)
+#define FX_Q16(num, den)   ((int32_t)((((int64_t)(num) << 16) + (den) / 2) / (den)))
+
+#define FX_ONE_Q16         0x00010000L
+#define FX_LN2_Q16         45426L        // ln(2) in Q16.16
+
+// Function Prototypes
+uint32_t FX_MulU16(uint16_t a, uint16_t b);      // 16x16 -> 32 unsigned
+int32_t  FX_MulS16(int16_t a, int16_t b);        // 16x16 -> 32 signed
+uint16_t FX_MulQ24(uint16_t x, uint32_t k);      // (x * k) >> 24, saturated
+int32_t  FX_MulHiS32(int32_t a, int32_t b);      // (a * b) >> 32, signed
+
+uint16_t FX_SatAddU16(uint16_t a, uint16_t b);
+uint16_t FX_SatSubU16(uint16_t a, uint16_t b);
+int16_t  FX_SatAddS16(int16_t a, int16_t b);
+uint16_t FX_SatU16(int32_t x);                   // Clamp to 0..65535
+int16_t  FX_SatS16(int32_t x);                   // Clamp to int16 range
+
+int32_t  FX_Log2Q16(uint32_t x);                 // log2(x) in Q16.16, x > 0
+int16_t  FX_EaseQ15(uint16_t phase);             // S-curve 0..32767 over a Q16 phase
+
+#endif
@@ -0,0 +1,24 @@
+#include "fram.h"
+
+uint16_t FRAM_Checksum(const void *data, uint16_t bytes) {
+    const uint16_t *word = (const uint16_t *)data;
+    uint16_t i;
+
+    // CRC16 hardware module, one word per write
+    CRCINIRES = 0xFFFF;
+    for (i = bytes >> 1; i > 0; i--) {
+        CRCDI = *word++;
+    }
+    return CRCINIRES;
+}
+
+void FRAM_Write(void *dest, const void *src, uint16_t bytes) {
+    uint8_t *d = (uint8_t *)dest;
+    const uint8_t *s = (const uint8_t *)src;
+
+    FRAM_WRITE_ENABLE();
+    while (bytes--) {
+        *d++ = *s++;
+    }
+    FRAM_WRITE_DISABLE();
+}
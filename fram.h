@@ -0,0 +1,17 @@
+#ifndef FRAM_H_
+#define FRAM_H_
+
+#include <msp430.h>
+#include <stdint.h>
+
+// #pragma PERSISTENT variables live in program FRAM (.TI.persistent),
+// which is write protected at runtime. Open the window only around the
+// store itself.
+#define FRAM_WRITE_ENABLE()    (SYSCFG0 = FRWPPW | DFWP)
+#define FRAM_WRITE_DISABLE()   (SYSCFG0 = FRWPPW | PFWP | DFWP)
+
+// Function Prototypes
+uint16_t FRAM_Checksum(const void *data, uint16_t bytes);   // CRC16-CCITT, word aligned
+void FRAM_Write(void *dest, const void *src, uint16_t bytes);
+
+#endif
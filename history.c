@@ -0,0 +1,129 @@
+#include "history.h"
+#include "fram.h"
+#include "metrics.h"
+
+#if (HISTORY_LOG_BYTES % HISTORY_BLOCK_BYTES) || (HISTORY_BLOCK_BYTES > 255)
+#error "HISTORY_LOG_BYTES must be whole blocks of at most 255 bytes"
+#endif
+
+#define RECORD_MAX_BYTES  (1 + HISTORY_SIGNALS * 3)   // Mask + 16-bit varints
+
+#pragma PERSISTENT(historyLog)
+uint8_t historyLog[HISTORY_LOG_BYTES] = { 0 };
+
+static uint8_t block = HISTORY_BLOCKS - 1;   // Block being appended to
+static uint8_t used = HISTORY_BLOCK_BYTES;   // Full, so the first sample opens a block
+static uint16_t seq = 0;
+static uint16_t bootId = 0;
+static uint16_t last[HISTORY_SIGNALS];
+
+static uint16_t GetU16(const uint8_t *p) {
+    return p[0] | ((uint16_t)p[1] << 8);
+}
+
+static uint8_t PutU16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return 2;
+}
+
+static uint8_t PutVarint(uint8_t *p, uint16_t v) {
+    uint8_t n = 0;
+    
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)v | 0x80;
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+// Sign into the low bit so small negative deltas stay one byte. Shift
+// the unsigned value: left-shifting a negative int16 is undefined.
+static uint16_t ZigZag(int16_t d) {
+    return (uint16_t)((uint16_t)d << 1) ^ (uint16_t)(d >> 15);
+}
+
+static void OpenBlock(uint32_t uptimeS) {
+    uint8_t key[HISTORY_KEY_BYTES];
+    uint8_t *base;
+    
+    block = (block + 1 < HISTORY_BLOCKS) ? block + 1 : 0;
+    base = &historyLog[(uint16_t)block * HISTORY_BLOCK_BYTES];
+    seq++;
+    
+    PutU16(&key[0], seq);
+    key[2] = HISTORY_KEY_BYTES;
+    key[3] = HISTORY_PERIOD_MS / 1000;
+    PutU16(&key[4], bootId);
+    PutU16(&key[6], (uint16_t)uptimeS);
+    PutU16(&key[8], (uint16_t)(uptimeS >> 16));
+    PutU16(&key[10], last[0]);
+    PutU16(&key[12], last[1]);
+    key[14] = (uint8_t)last[2];
+    
+    // Sequence number last, so a block cut short by a reset never looks
+    // like the newest one
+    FRAM_Write(base + 2, &key[2], HISTORY_KEY_BYTES - 2);
+    FRAM_Write(base, &key[0], 2);
+    used = HISTORY_KEY_BYTES;
+    
+    Metrics_Add(METRIC_HISTORY_BYTES, HISTORY_KEY_BYTES);
+}
+
+// Resume after the newest block; every boot opens a fresh keyframe
+void History_Init(uint16_t boot) {
+    uint8_t i;
+    uint8_t found = 0;
+    
+    bootId = boot;
+    for (i = 0; i < HISTORY_BLOCKS; i++) {
+        const uint8_t *base = &historyLog[(uint16_t)i * HISTORY_BLOCK_BYTES];
+        uint16_t s = GetU16(base);
+        
+        if (base[2] < HISTORY_KEY_BYTES) continue;    // Never written
+        if (!found || (int16_t)(s - seq) > 0) {
+            seq = s;
+            block = i;
+            found = 1;
+        }
+    }
+    used = HISTORY_BLOCK_BYTES;
+}
+
+void History_Record(uint32_t uptimeS, uint16_t flame, int16_t room, uint8_t valve) {
+    uint16_t start = METRICS_NOW();
+    uint16_t value[HISTORY_SIGNALS];
+    uint8_t record[RECORD_MAX_BYTES];
+    uint8_t n = 1;
+    uint8_t i;
+    
+    value[0] = flame;
+    value[1] = (uint16_t)room;
+    value[2] = valve;
+    
+    if (used + RECORD_MAX_BYTES > HISTORY_BLOCK_BYTES) {
+        // Keyframe carries this sample in full
+        for (i = 0; i < HISTORY_SIGNALS; i++) last[i] = value[i];
+        OpenBlock(uptimeS);
+    } else {
+        record[0] = 0;
+        for (i = 0; i < HISTORY_SIGNALS; i++) {
+            if (value[i] != last[i]) {
+                record[0] |= (1 << i);
+                n += PutVarint(&record[n], ZigZag((int16_t)(value[i] - last[i])));
+                last[i] = value[i];
+            }
+        }
+        
+        uint8_t *base = &historyLog[(uint16_t)block * HISTORY_BLOCK_BYTES];
+        FRAM_Write(base + used, record, n);
+        used += n;
+        FRAM_Write(base + 2, &used, 1);
+        
+        Metrics_Add(METRIC_HISTORY_BYTES, n);
+    }
+    
+    Metrics_Count(METRIC_HISTORY_SAMPLES);
+    Metrics_Observe(METRIC_HISTORY_ENCODE, METRICS_NOW() - start);
+}
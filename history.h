@@ -0,0 +1,35 @@
+#ifndef HISTORY_H_
+#define HISTORY_H_
+
+#include <stdint.h>
+
+// Streaming sensor history in a circular FRAM log, for incident review.
+// The log is split into blocks; each block opens with a keyframe of
+// absolute values, followed by records of zig-zag varint deltas, so any
+// block decodes on its own (tools/history_decode.py).
+#define HISTORY_PERIOD_MS     10000   // Sample rate
+#define HISTORY_LOG_BYTES     4096    // FRAM budget, multiple of HISTORY_BLOCK_BYTES
+#define HISTORY_BLOCK_BYTES   128
+#define HISTORY_BLOCKS        (HISTORY_LOG_BYTES / HISTORY_BLOCK_BYTES)
+
+// Keyframe layout (little-endian):
+//   0  seq        uint16  block sequence number, written last
+//   2  used       uint8   bytes used in the block, keyframe included
+//   3  period     uint8   sample period in seconds
+//   4  boot       uint16  reset count (bootRecord.resets)
+//   6  time       uint32  uptime of the keyframe sample in seconds
+//   10 flame      uint16  filtered thermocouple ADC
+//   12 room       int16   thermistor, 0.01°C
+//   14 valve      uint8   valve duty, percent
+// Record: one mask byte (bit n set = signal n changed), then one
+// zig-zag varint delta per changed signal, in keyframe order.
+#define HISTORY_KEY_BYTES     15
+#define HISTORY_SIGNALS       3
+
+extern uint8_t historyLog[HISTORY_LOG_BYTES];
+
+// Function Prototypes
+void History_Init(uint16_t boot);
+void History_Record(uint32_t uptimeS, uint16_t flame, int16_t room, uint8_t valve);
+
+#endif
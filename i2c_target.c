@@ -0,0 +1,123 @@
+#include "i2c_target.h"
+#include "ramfunc.h"
+#include <msp430.h>
+
+// Double-buffered snapshot: main fills one while the ISR serves the other
+static RegisterMap snapshots[2];
+static volatile uint8_t published = 0;           // Index the ISR latches at START
+static const uint8_t * volatile serving = 0;     // Buffer of the transfer in progress
+
+// Per-transfer write capture, committed at STOP if main has taken the last one
+static uint8_t writeBytes[REG_WRITABLE_LAST + 1];
+static uint16_t writeMask = 0;
+static RegisterWrites committed;
+static volatile uint8_t writesPending = 0;
+
+void I2CTarget_Init(void) {
+    // P4.6/P4.7 to eUSCI_B1 (external pull-ups)
+    P4SEL0 |= I2C_TARGET_PINS;
+    P4SEL1 &= ~I2C_TARGET_PINS;
+    
+    UCB1CTLW0 = UCSWRST;                          // Hold in reset while configuring
+    UCB1CTLW0 |= UCMODE_3 | UCSYNC;               // I2C target mode
+    UCB1I2COA0 = I2C_TARGET_ADDRESS | UCOAEN;     // Own address enabled
+    UCB1CTLW0 &= ~UCSWRST;
+    UCB1IE |= UCRXIE0 | UCTXIE0 | UCSTTIE | UCSTPIE;
+}
+
+void I2CTarget_Publish(const RegisterMap *snapshot) {
+    uint8_t next = published ^ 1;
+    
+    // Never overwrite the buffer a transfer is still reading; the master
+    // just sees this tick's values one tick later
+    if (serving == (const uint8_t *)&snapshots[next]) return;
+    
+    snapshots[next] = *snapshot;
+    published = next;
+}
+
+// Hand the captured writes over if the main loop has taken the last set
+static RAMFUNC void CommitWrites(void) {
+    if (!writeMask || writesPending) return;
+    committed.mask = writeMask;
+    committed.heatDemand = writeBytes[REG_HEAT_DEMAND];
+    committed.firingRate = writeBytes[REG_FIRING_RATE];
+    committed.targetTemp = (int16_t)(writeBytes[REG_TARGET_TEMP] |
+                                     ((uint16_t)writeBytes[REG_TARGET_TEMP + 1] << 8));
+    writeMask = 0;
+    writesPending = 1;
+}
+
+uint8_t I2CTarget_TakeWrites(RegisterWrites *writes) {
+    uint16_t gie;
+    
+    if (!writesPending) return 0;
+    *writes = committed;
+    
+    // Writes captured while this set was held go next, without waiting
+    // for another STOP; mid-transfer, that transfer's STOP hands them over
+    gie = __get_interrupt_state();
+    __disable_interrupt();
+    writesPending = 0;
+    if (!serving) CommitWrites();
+    __set_interrupt_state(gie);
+    return 1;
+}
+
+// eUSCI_B1: byte-level work only, never waits on the main loop
+#pragma vector=EUSCI_B1_VECTOR
+RAMFUNC __interrupt void EUSCI_B1_ISR(void) {
+    static uint8_t pointer = 0;
+    static uint8_t pointerSet = 0;
+    static uint8_t tempLow;              // Target temperature low byte, this transfer
+    static uint8_t tempLowSet = 0;
+    
+    switch(__even_in_range(UCB1IV, USCI_I2C_UCBIT9IFG)) {
+        case USCI_I2C_UCSTTIFG:
+            // Latch a coherent snapshot for the whole transfer
+            serving = (const uint8_t *)&snapshots[published];
+            pointerSet = 0;
+            tempLowSet = 0;
+            break;
+            
+        case USCI_I2C_UCRXIFG0: {
+            uint8_t data = UCB1RXBUF;
+            if (!pointerSet) {
+                pointer = data;
+                pointerSet = 1;
+            } else {
+                // Bound the pointer before shifting: unsigned is 16 bits here
+                if (pointer == REG_TARGET_TEMP) {
+                    // Held until its high byte arrives, so the main loop
+                    // never sees half of a new value
+                    tempLow = data;
+                    tempLowSet = 1;
+                } else if (pointer == REG_TARGET_TEMP + 1) {
+                    if (tempLowSet) {
+                        writeBytes[REG_TARGET_TEMP] = tempLow;
+                        writeBytes[REG_TARGET_TEMP + 1] = data;
+                        writeMask |= 3U << REG_TARGET_TEMP;
+                    }
+                } else if (pointer <= REG_WRITABLE_LAST && (REG_WRITABLE_MASK & (1U << pointer))) {
+                    writeBytes[pointer] = data;
+                    writeMask |= 1U << pointer;
+                }
+                if (pointer != 0xFF) pointer++;     // Stick past the end, never wrap
+            }
+            break;
+        }
+            
+        case USCI_I2C_UCTXIFG0:
+            UCB1TXBUF = (pointer < sizeof(RegisterMap)) ? serving[pointer] : 0xFF;
+            if (pointer != 0xFF) pointer++;
+            break;
+            
+        case USCI_I2C_UCSTPIFG:
+            serving = 0;
+            CommitWrites();
+            break;
+            
+        default:
+            break;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef I2C_TARGET_H_
+#define I2C_TARGET_H_
+
+#include <stdint.h>
+
+// eUSCI_B1 I2C target (P4.6 = SDA, P4.7 = SCL; eUSCI_B0 pins clash with A3)
+#define I2C_TARGET_ADDRESS   0x48
+#define I2C_TARGET_PINS      (BIT6 | BIT7)   // P4.6/P4.7
+#define REGMAP_VERSION       1
+
+// Register map as seen by the bus master. The first byte of a write sets
+// the register pointer, further bytes write from it; reads continue from
+// the pointer. Both auto-increment. 16-bit values are little-endian.
+typedef struct {
+    uint8_t  version;          // 0x00 R   REGMAP_VERSION
+    uint8_t  state;            // 0x01 R   SystemState
+    uint8_t  heatDemand;       // 0x02 R/W 1 = call for heat (ORed with P4.1)
+    uint8_t  firingRate;       // 0x03 R/W Requested rate 1-100%, 0 = use potentiometer
+    int16_t  targetTemp;       // 0x04 R/W Target temperature (0.01°C)
+    int16_t  roomTemp;         // 0x06 R   Thermistor temperature (0.01°C)
+    uint16_t flameSignal;      // 0x08 R   Filtered thermocouple ADC value
+    uint8_t  valvePercent;     // 0x0A R   Current main valve setpoint
+    uint8_t  lockoutReason;    // 0x0B R   LockoutReason
+    uint16_t ignitions;        // 0x0C R   Successful ignitions
+    uint16_t failures;         // 0x0E R   Ignition trials that timed out
+    uint16_t flameLosses;      // 0x10 R   Flame losses during prove/early burn
+} RegisterMap;
+
+#define REG_HEAT_DEMAND   0x02
+#define REG_FIRING_RATE   0x03
+#define REG_TARGET_TEMP   0x04
+#define REG_WRITABLE_LAST 0x05       // Highest writable byte
+#define REG_WRITABLE_MASK 0x003C     // Bytes 0x02-0x05
+
+// Values written by the master, handed to the main loop at STOP. A
+// 16-bit register counts as written only when both of its bytes were
+// written in the same transfer.
+typedef struct {
+    uint16_t mask;             // Bit n set = register byte n was written
+    uint8_t  heatDemand;
+    uint8_t  firingRate;
+    int16_t  targetTemp;
+} RegisterWrites;
+
+// Function Prototypes
+void I2CTarget_Init(void);
+void I2CTarget_Publish(const RegisterMap *snapshot);
+uint8_t I2CTarget_TakeWrites(RegisterWrites *writes);   // 1 = new writes
+
+#endif
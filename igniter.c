@@ -0,0 +1,39 @@
+#include "igniter.h"
+#include <msp430.h>
+
+static const SparkProfile sparkProfiles[IGNITER_PROFILES] = {
+    { IGNITER_HZ(15), IGNITER_US(1000) },     // 15Hz, 1ms
+    { IGNITER_HZ(25), IGNITER_US(1000) },     // 25Hz, 1ms
+    { IGNITER_HZ(40), IGNITER_US(1500) },     // 40Hz, 1.5ms
+};
+
+void Igniter_Init(void) {
+    // Indicator LED off
+    P5DIR |= IGNITER_LED_PIN;
+    P5OUT &= ~IGNITER_LED_PIN;
+    
+    // P1.6 to TB0.1 (secondary function), held low with the timer stopped
+    P1DIR |= IGNITER_SPARK_PIN;
+    P1SEL0 &= ~IGNITER_SPARK_PIN;
+    P1SEL1 |= IGNITER_SPARK_PIN;
+    Igniter_Stop();
+}
+
+// Two register writes start the train; the timer gates every spark
+// until Igniter_Stop, with no interrupts in between
+void Igniter_Start(uint8_t trial) {
+    if (trial < 1) trial = 1;
+    if (trial > IGNITER_PROFILES) trial = IGNITER_PROFILES;
+    const SparkProfile *profile = &sparkProfiles[trial - 1];
+    
+    TB0CTL = MC__STOP | TBCLR;
+    TB0CCR0 = profile->period - 1;
+    TB0CCR1 = profile->pulse;
+    TB0CCTL1 = OUTMOD_7;                   // Reset/set: high for 'pulse' each period
+    TB0CTL = TBSSEL__ACLK | MC__UP | TBCLR;
+}
+
+void Igniter_Stop(void) {
+    TB0CTL = MC__STOP;
+    TB0CCTL1 = OUTMOD_0;                   // OUT = 0 drives the pin low
+}
@@ -0,0 +1,30 @@
+#ifndef IGNITER_H_
+#define IGNITER_H_
+
+#include <stdint.h>
+
+// Spark driver on Timer_B0: TB0.1 (P1.6) pulse train, generated entirely
+// by the timer once started. P5.4 has no timer function on the FR2355,
+// so it stays the igniter-active indicator LED, driven by the output
+// stage (outputs.c).
+#define IGNITER_LED_PIN     BIT4    // P5.4 - Igniter active LED
+#define IGNITER_SPARK_PIN   BIT6    // P1.6 - TB0.1 spark driver
+
+// ACLK conversions for the spark profile table
+#define IGNITER_HZ(hz)      (uint16_t)(32768UL / (hz))
+#define IGNITER_US(us)      (uint16_t)(((us) * 32768UL + 500000UL) / 1000000UL)
+
+// Spark rate and energy per trial; later trials spark faster and longer
+typedef struct {
+    uint16_t period;        // ACLK ticks between sparks
+    uint16_t pulse;         // ACLK ticks the driver is on per spark
+} SparkProfile;
+
+#define IGNITER_PROFILES    3       // Trials past this reuse the last
+
+// Function Prototypes
+void Igniter_Init(void);
+void Igniter_Start(uint8_t trial);  // trial counts from 1
+void Igniter_Stop(void);
+
+#endif
@@ -0,0 +1,128 @@
+#include "ignition.h"
+#include "fixmath.h"
+#include "fram.h"
+
+#define IGNITION_MAGIC  0x1641
+
+#pragma PERSISTENT(ignitionParams)
+IgnitionParams ignitionParams = { 0 };
+
+// Working copy in RAM, committed to FRAM after each update
+static IgnitionParams params;
+
+static void saveParams(void) {
+    params.checksum = FRAM_Checksum(&params, sizeof(params) - sizeof(params.checksum));
+    FRAM_Write(&ignitionParams, &params, sizeof(params));
+}
+
+static void resetParams(void) {
+    params.magic = IGNITION_MAGIC;
+    params.samples = 0;
+    params.ignitions = 0;
+    params.failures = 0;
+    params.flameLosses = 0;
+    params.meanTtf = IGNITION_TRIAL_MAX;
+    params.devTtf = 0;
+    params.maxTtf = 0;
+    params.meanLatency = 0;
+    params.trialTime = IGNITION_TRIAL_MAX;
+}
+
+// EWMA step: avg += (sample - avg) / 2^IGNITION_EWMA_SHIFT. The
+// difference spans the full uint16_t range either way (latencies over
+// several trials exceed 32767ms), so it is taken in 32 bits.
+static uint16_t average(uint16_t avg, uint16_t sample) {
+    int32_t step = ((int32_t)sample - (int32_t)avg) >> IGNITION_EWMA_SHIFT;
+    if (step == 0 && sample != avg) step = (sample > avg) ? 1 : -1;
+    return (uint16_t)(avg + step);
+}
+
+static void updateTrialTime(void) {
+    uint16_t trial;
+
+    // Stay at the hard limit until enough stable ignitions are seen
+    if (params.samples < IGNITION_MIN_SAMPLES) {
+        params.trialTime = IGNITION_TRIAL_MAX;
+        return;
+    }
+
+    trial = FX_SatAddU16(params.meanTtf, FX_SatAddU16(params.devTtf << 2, IGNITION_MARGIN));
+    if (trial < params.maxTtf) trial = params.maxTtf;
+
+    if (trial < IGNITION_TRIAL_MIN) trial = IGNITION_TRIAL_MIN;
+    if (trial > IGNITION_TRIAL_MAX) trial = IGNITION_TRIAL_MAX;
+    params.trialTime = trial;
+}
+
+void Ignition_Init(void) {
+    params = ignitionParams;
+
+    if (params.magic != IGNITION_MAGIC ||
+        params.checksum != FRAM_Checksum(&params, sizeof(params) - sizeof(params.checksum))) {
+        resetParams();
+        saveParams();
+    }
+    updateTrialTime();
+}
+
+uint16_t Ignition_TrialTime(uint8_t trial) {
+    // Only the first trial is shortened; retries always get the full limit
+    return (trial <= 1) ? params.trialTime : IGNITION_TRIAL_MAX;
+}
+
+uint16_t Ignition_RetryDelay(uint16_t trialElapsed) {
+    // Gas released scales with how long the pilot was open, so the purge
+    // before the next trial scales with it too
+    uint16_t delay = FX_MulQ24(trialElapsed, FX_Q24(RETRY_DELAY_MAX, IGNITION_TRIAL_MAX));
+
+    if (delay < RETRY_DELAY_MIN) delay = RETRY_DELAY_MIN;
+    if (delay > RETRY_DELAY_MAX) delay = RETRY_DELAY_MAX;
+    return delay;
+}
+
+void Ignition_RecordFlame(uint16_t timeToFlame) {
+    uint16_t deviation;
+
+    if (params.samples == 0) {
+        params.meanTtf = timeToFlame;
+        params.devTtf = timeToFlame >> 2;
+    } else {
+        deviation = (timeToFlame > params.meanTtf) ? timeToFlame - params.meanTtf
+                                                   : params.meanTtf - timeToFlame;
+        params.meanTtf = average(params.meanTtf, timeToFlame);
+        params.devTtf = average(params.devTtf, deviation);
+    }
+    if (timeToFlame > params.maxTtf) params.maxTtf = timeToFlame;
+
+    params.ignitions = FX_SatAddU16(params.ignitions, 1);
+    params.samples = FX_SatAddU16(params.samples, 1);
+    updateTrialTime();
+    saveParams();
+}
+
+void Ignition_RecordFailure(void) {
+    params.failures = FX_SatAddU16(params.failures, 1);
+
+    // A timeout inside the learned window means the model is wrong;
+    // widen the worst case so the next first trial is longer
+    if (params.trialTime < IGNITION_TRIAL_MAX) {
+        params.maxTtf = params.trialTime + IGNITION_MARGIN;
+    }
+    updateTrialTime();
+    saveParams();
+}
+
+void Ignition_RecordFlameLoss(void) {
+    // Unstable flame: distrust what was learned and relearn from scratch
+    params.flameLosses = FX_SatAddU16(params.flameLosses, 1);
+    params.samples = 0;
+    params.maxTtf = 0;
+    updateTrialTime();
+    saveParams();
+}
+
+void Ignition_RecordLatency(uint16_t latency) {
+    params.meanLatency = (params.meanLatency == 0) ? latency
+                                                   : average(params.meanLatency, latency);
+    saveParams();
+}
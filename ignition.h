@@ -0,0 +1,43 @@
+#ifndef IGNITION_H_
+#define IGNITION_H_
+
+#include <stdint.h>
+
+// Hard safety limits (fixed at compile time, learning stays inside them)
+#define IGNITION_TRIAL_MAX     10000  // Max igniter-on time per trial (ms)
+#define IGNITION_TRIAL_MIN     2000   // Learned trial never shorter (ms)
+#define RETRY_DELAY_MAX        5000   // Max delay between trials (ms)
+#define RETRY_DELAY_MIN        2000   // Min delay between trials (ms)
+
+// Learning configuration
+#define IGNITION_MIN_SAMPLES   8      // Stable ignitions before adapting
+#define IGNITION_MARGIN        500    // Extra time on top of mean + 4*dev (ms)
+#define IGNITION_EWMA_SHIFT    3      // Averaging weight 1/8
+
+// Learned parameters, kept in FRAM across resets
+typedef struct {
+    uint16_t magic;
+    uint16_t samples;         // Stable ignitions since last reset/instability
+    uint16_t ignitions;       // Total successful ignitions
+    uint16_t failures;        // Trials that timed out
+    uint16_t flameLosses;     // Flame lost during prove or early burn
+    uint16_t meanTtf;         // Average time-to-flame (ms)
+    uint16_t devTtf;          // Average deviation of time-to-flame (ms)
+    uint16_t maxTtf;          // Longest time-to-flame seen (ms)
+    uint16_t meanLatency;     // Average heat-request-to-main-valve (ms)
+    uint16_t trialTime;       // Learned first-trial igniter-on limit (ms)
+    uint16_t checksum;
+} IgnitionParams;
+
+extern IgnitionParams ignitionParams;
+
+// Function Prototypes
+void Ignition_Init(void);
+uint16_t Ignition_TrialTime(uint8_t trial);          // trial counts from 1
+uint16_t Ignition_RetryDelay(uint16_t trialElapsed);
+void Ignition_RecordFlame(uint16_t timeToFlame);
+void Ignition_RecordFailure(void);
+void Ignition_RecordFlameLoss(void);
+void Ignition_RecordLatency(uint16_t latency);
+
+#endif
@@ -149,12 +149,15 @@ SECTIONS
         {
             .text       : {}                   /* Code                              */
             .text:_isr  : {}                   /* Code ISRs                         */
-        }
+        } RUN_END(fram_rx_end)                 /* End of self-tested FRAM (selftest.c) */
     } > FRAM
 
     #ifdef __TI_COMPILER_VERSION__
         #if __TI_COMPILER_VERSION__ >= 15009000
-            .TI.ramfunc : {} load=FRAM, run=RAM, table(BINIT)
+            /* Hot ISRs and control tick (RAMFUNC in ramfunc.h), copied  */
+            /* to RAM at boot so they run without FRAM wait states        */
+            .TI.ramfunc : {} load=FRAM, run=RAM, table(BINIT),
+                          RUN_START(ramfunc_start), RUN_END(ramfunc_end)
         #endif
     #endif
 
@@ -164,9 +167,12 @@ SECTIONS
     .bslconfig          : {} > BSLCONFIGURATION
     .bsli2caddress      : {} > BSLI2CADDRESS
 
-    .bss        : {} > RAM                  /* Global & static vars              */
-    .data       : {} > RAM                  /* Global & static vars              */
-    .TI.noinit  : {} > RAM                  /* For #pragma noinit                */
+    GROUP(RAM_DATA)
+    {
+        .bss        : {}                    /* Global & static vars              */
+        .data       : {}                    /* Global & static vars              */
+        .TI.noinit  : {}                    /* For #pragma noinit                */
+    } > RAM, RUN_START(ram_data_start), RUN_END(ram_data_end)
     .stack      : {} > RAM (HIGH)           /* Software system stack             */
 
     .tinyram    : {} > TINYRAM              /* Tiny RAM                          */
@@ -1,361 +1,668 @@
-/*
- * Electronic Ignition Variable Gas Valve Control Module
- * Main Control System
- * 
- * This file integrates all the subsystems:
- * - Temperature sensing (thermistor/thermocouple)
- * - Heat request detection
- * - Pilot ignition sequence
- * - Main valve control
- * - Status indicators
- */
-
-#include <msp430.h>
-#include <stdint.h>
-#include "SENSORS.h"
-#include "valve_control.h"
-#include "thermistor.h"
-#include "thermocouple.h"
-#include "potentiometer.h"
-
-// System state definitions
-typedef enum {
-    STATE_IDLE,           // System idle, waiting for heat request
-    STATE_PREPURGE,       // Pre-purge sequence
-    STATE_PILOT_IGNITION, // Igniting pilot
-    STATE_PILOT_PROVE,    // Verifying pilot flame
-    STATE_MAIN_VALVE,     // Main valve operation
-    STATE_SHUTDOWN,       // Normal shutdown sequence
-    STATE_LOCKOUT         // Safety shutdown
-} SystemState;
-
-// External function declarations (from other .c files)
-extern void Pilot_Init(void);
-extern void Pilot_Close(void);
-extern void Heat_On(void);
-extern char Pilot_open(void);
-extern void Pilot_State(char pilot_status);
-extern void Igniter_Init(void);
-
-// Hardware pins
-#define HEAT_REQUEST_PIN  BIT1  // P4.1 - Heat request input
-#define SAFETY_SWITCH_PIN BIT3  // P2.3 - Safety switch
-#define STATUS_GREEN_PIN  BIT6  // P6.6 - Green status LED
-#define STATUS_RED_PIN    BIT0  // P1.0 - Red status LED
-#define IGNITER_LED_PIN   BIT4  // P5.4 - Igniter LED
-
-// Constants
-#define PREPURGE_TIME     3000  // Pre-purge time in milliseconds
-#define IGNITION_TRIAL    10000 // Max ignition trial time in milliseconds
-#define FLAME_PROVE_TIME  1000  // Time to verify stable flame (milliseconds)
-#define MAX_TRIALS        3     // Maximum ignition trials before lockout
-#define RETRY_DELAY       5000  // Delay between trials (milliseconds)
-
-// Global variables
-volatile SystemState currentState = STATE_IDLE;
-volatile uint16_t systemTimer = 0;
-volatile uint8_t ignitionTrials = 0;
-volatile uint8_t pilotValveOpen = 0;
-volatile uint8_t mainValveEnabled = 0;
-
-// Function prototypes
-void initSystem(void);
-void processState(void);
-void updateOutputs(void);
-void delay_ms(uint16_t ms);
-void setStatusLED(uint8_t green, uint8_t red);
-
-int main(void) {
-    // Stop watchdog timer
-    WDTCTL = WDTPW | WDTHOLD;
-    
-    // Initialize system
-    initSystem();
-    
-    // Main loop
-    while (1) {
-        // Process current state
-        processState();
-        
-        // Update physical outputs
-        updateOutputs();
-        
-        // Small delay for debouncing and stability
-        delay_ms(10);
-    }
-}
-
-void initSystem(void) {
-    // Disable the GPIO power-on default high-impedance mode
-    PM5CTL0 &= ~LOCKLPM5;
-    
-    // Initialize subsystems
-    initADC();              // Initialize ADC
-    Thermocouple_Init();    // Initialize thermocouple
-    thermistor_InitADC();   // Initialize thermistor
-    Pilot_Init();           // Initialize pilot valve
-    Igniter_Init();         // Initialize igniter
-    Valve_Init();           // Initialize main valve
-    Pot_Init();             // Initialize potentiometer
-    
-    // Configure heat request input pin (P4.1)
-    P4DIR &= ~HEAT_REQUEST_PIN;   // Input
-    P4REN |= HEAT_REQUEST_PIN;    // Enable pull-up/down
-    P4OUT |= HEAT_REQUEST_PIN;    // Pull-up
-    P4IES |= HEAT_REQUEST_PIN;    // High to low transition
-    P4IE |= HEAT_REQUEST_PIN;     // Enable interrupt
-    P4IFG &= ~HEAT_REQUEST_PIN;   // Clear interrupt flag
-    
-    // Configure safety switch input (P2.3)
-    P2DIR &= ~SAFETY_SWITCH_PIN;  // Input
-    P2REN |= SAFETY_SWITCH_PIN;   // Enable pull-up/down
-    P2OUT |= SAFETY_SWITCH_PIN;   // Pull-up
-    P2IES |= SAFETY_SWITCH_PIN;   // High to low transition
-    P2IE |= SAFETY_SWITCH_PIN;    // Enable interrupt
-    P2IFG &= ~SAFETY_SWITCH_PIN;  // Clear interrupt flag
-    
-    // Configure status LEDs
-    P6DIR |= STATUS_GREEN_PIN;    // Output
-    P1DIR |= STATUS_RED_PIN;      // Output
-    P6OUT &= ~STATUS_GREEN_PIN;   // Initially off
-    P1OUT &= ~STATUS_RED_PIN;     // Initially off
-    
-    // Configure Timer A0 for 1ms ticks
-    TA0CCR0 = 1000-1;            // 1ms @ 1MHz
-    TA0CCTL0 = CCIE;             // Enable interrupt
-    TA0CTL = TASSEL__SMCLK | MC__UP | TACLR | ID__1; // SMCLK, up mode, clear
-    
-    // Enable global interrupts
-    __enable_interrupt();
-    
-    // Initial state
-    currentState = STATE_IDLE;
-    setStatusLED(1, 0);  // Green on, Red off in idle
-}
-
-void processState(void) {
-    static uint16_t stateTimer = 0;
-    uint8_t flameDetected = 0;
-    
-    // Check for flame
-    flameDetected = Thermocouple_FlameDetected();
-    
-    // Process based on current state
-    switch (currentState) {
-        case STATE_IDLE:
-            // Check if heat is requested
-            if (!(P4IN & HEAT_REQUEST_PIN)) {
-                currentState = STATE_PREPURGE;
-                stateTimer = 0;
-                setStatusLED(0, 1);  // Green off, Red on during sequence
-            }
-            break;
-            
-        case STATE_PREPURGE:
-            // Wait for prepurge time
-            if (stateTimer >= PREPURGE_TIME) {
-                currentState = STATE_PILOT_IGNITION;
-                stateTimer = 0;
-                ignitionTrials = 0;
-            }
-            break;
-            
-        case STATE_PILOT_IGNITION:
-            // Open pilot valve and start ignition
-            if (stateTimer == 0) {
-                Heat_On();  // Open pilot valve
-                pilotValveOpen = 1;
-                // Igniter on - simulated with LED
-                P5OUT |= IGNITER_LED_PIN;
-                ignitionTrials++;
-            }
-            
-            // Check if flame is detected
-            if (flameDetected) {
-                currentState = STATE_PILOT_PROVE;
-                stateTimer = 0;
-                // Turn off igniter
-                P5OUT &= ~IGNITER_LED_PIN;
-            }
-            
-            // Check for timeout
-            if (stateTimer >= IGNITION_TRIAL) {
-                // Turn off igniter
-                P5OUT &= ~IGNITER_LED_PIN;
-                
-                // Close pilot valve
-                Pilot_Close();
-                pilotValveOpen = 0;
-                
-                // Check if we've reached max trials
-                if (ignitionTrials >= MAX_TRIALS) {
-                    currentState = STATE_LOCKOUT;
-                } else {
-                    // Wait before retry
-                    stateTimer = 0;
-                    currentState = STATE_PREPURGE;
-                    delay_ms(RETRY_DELAY);
-                }
-            }
-            break;
-            
-        case STATE_PILOT_PROVE:
-            // Verify flame stability for a short period
-            if (!flameDetected) {
-                // Flame lost during prove period
-                currentState = STATE_SHUTDOWN;
-                stateTimer = 0;
-            } else if (stateTimer >= FLAME_PROVE_TIME) {
-                // Flame proven stable, open main valve
-                currentState = STATE_MAIN_VALVE;
-                stateTimer = 0;
-                mainValveEnabled = 1;
-                
-                // Set main valve flow based on potentiometer
-                int16_t setpoint = Pot_Read();
-                Valve_Set((uint8_t)setpoint);
-                
-                // Set status LED to indicate heat active
-                setStatusLED(1, 1);  // Both LEDs on during heating
-            }
-            break;
-            
-        case STATE_MAIN_VALVE:
-            // Normal operation - monitor flame and controls
-            
-            // Update valve position based on potentiometer
-            int16_t setpoint = Pot_Read();
-            Valve_Set((uint8_t)setpoint);
-            
-            // Check if flame is lost
-            if (!flameDetected) {
-                currentState = STATE_SHUTDOWN;
-                stateTimer = 0;
-            }
-            
-            // Check if heat request is removed
-            if (P4IN & HEAT_REQUEST_PIN) {
-                currentState = STATE_SHUTDOWN;
-                stateTimer = 0;
-            }
-            break;
-            
-        case STATE_SHUTDOWN:
-            // Close main valve immediately
-            mainValveEnabled = 0;
-            Valve_Set(0);
-            
-            // Keep pilot valve open briefly to ensure clean shutdown
-            if (stateTimer >= 1000) {  // 1 second delay
-                Pilot_Close();
-                pilotValveOpen = 0;
-                currentState = STATE_IDLE;
-                stateTimer = 0;
-                
-                // Return to idle state indicators
-                setStatusLED(1, 0);  // Green on, Red off
-            }
-            break;
-            
-        case STATE_LOCKOUT:
-            // Lockout state - all valves closed, requires manual reset
-            Pilot_Close();
-            pilotValveOpen = 0;
-            mainValveEnabled = 0;
-            Valve_Set(0);
-            
-            // Blink red LED to indicate lockout
-            if ((stateTimer % 500) < 250) {
-                P1OUT |= STATUS_RED_PIN;
-            } else {
-                P1OUT &= ~STATUS_RED_PIN;
-            }
-            P6OUT &= ~STATUS_GREEN_PIN;  // Green off
-            
-            // Check for reset (both buttons pressed)
-            if (!(P4IN & HEAT_REQUEST_PIN) && !(P2IN & SAFETY_SWITCH_PIN)) {
-                delay_ms(1000);  // Debounce and confirm
-                if (!(P4IN & HEAT_REQUEST_PIN) && !(P2IN & SAFETY_SWITCH_PIN)) {
-                    currentState = STATE_IDLE;
-                    stateTimer = 0;
-                    setStatusLED(1, 0);  // Green on, Red off
-                }
-            }
-            break;
-    }
-    
-    // Update state timer
-    stateTimer++;
-}
-
-void updateOutputs(void) {
-    // Update pilot valve state
-    Pilot_State(pilotValveOpen);
-    
-    // Safety check: if safety switch is triggered, force shutdown
-    if (!(P2IN & SAFETY_SWITCH_PIN)) {
-        if (currentState != STATE_LOCKOUT && currentState != STATE_IDLE) {
-            currentState = STATE_SHUTDOWN;
-        }
-    }
-}
-
-void setStatusLED(uint8_t green, uint8_t red) {
-    if (green) {
-        P6OUT |= STATUS_GREEN_PIN;
-    } else {
-        P6OUT &= ~STATUS_GREEN_PIN;
-    }
-    
-    if (red) {
-        P1OUT |= STATUS_RED_PIN;
-    } else {
-        P1OUT &= ~STATUS_RED_PIN;
-    }
-}
-
-void delay_ms(uint16_t ms) {
-    systemTimer = 0;
-    while (systemTimer < ms);
-}
-
-// Button 1 interrupt (heat request)
-#pragma vector=PORT4_VECTOR
-__interrupt void Port_4_ISR(void) {
-    if (P4IFG & HEAT_REQUEST_PIN) {
-        // Toggle interrupt edge
-        P4IES ^= HEAT_REQUEST_PIN;
-        
-        P4IFG &= ~HEAT_REQUEST_PIN;  // Clear interrupt flag
-    }
-}
-
-// Button 2 interrupt (safety switch)
-#pragma vector=PORT2_VECTOR
-__interrupt void Port_2_ISR(void) {
-    if (P2IFG & SAFETY_SWITCH_PIN) {
-        // Toggle interrupt edge
-        P2IES ^= SAFETY_SWITCH_PIN;
-        
-        P2IFG &= ~SAFETY_SWITCH_PIN;  // Clear interrupt flag
-    }
-}
-
-// Timer A0 interrupt for millisecond timing
-#pragma vector=TIMER0_A0_VECTOR
-__interrupt void Timer_A0_ISR(void) {
-    systemTimer++;
-}
-
-// ADC interrupt service routine
-#pragma vector=ADC_VECTOR
-__interrupt void ADC_ISR(void) {
-    switch(__even_in_range(ADCIV, ADCIV_ADCIFG)) {
-        case ADCIV_ADCIFG:
-            ADCResult = ADCMEM0;
-            ADCFinished = 1;
-            break;
-        default:
-            break;
-    }
+/*
+ * Electronic Ignition Variable Gas Valve Control Module
+ * Main Control System
+ * 
+ * This file integrates all the subsystems:
+ * - Temperature sensing (thermistor/thermocouple)
+ * - Heat request detection
+ * - Pilot ignition sequence
+ * - Main valve control
+ * - Status indicators
+ */
+
+#include <msp430.h>
+#include <stdint.h>
+#include "SENSORS.h"
+#include "main_valve.h"
+#include "thermistor.h"
+#include "thermocouple.h"
+#include "potentiometer.h"
+#include "events.h"
+#include "ignition.h"
+#include "fixmath.h"
+#include "boot.h"
+#include "system_state.h"
+#include "status_led.h"
+#include "ramfunc.h"
+#include "i2c_target.h"
+#include "metrics.h"
+#include "timebase.h"
+#include "sampling.h"
+#include "history.h"
+#include "selftest.h"
+#include "thermostat.h"
+#include "igniter.h"
+#include "demand.h"
+#include "outputs.h"
+#include "pilot_valve.h"
+
+// Hardware pins
+#define HEAT_REQUEST_PIN  BIT1  // P4.1 - Heat request input
+#define SAFETY_SWITCH_PIN BIT3  // P2.3 - Safety switch
+// Actuator and status LED pins are in outputs.h
+
+// Constants
+#define PREPURGE_TIME     3000  // Pre-purge time in milliseconds
+#define FLAME_PROVE_TIME  1000  // Time to verify stable flame (milliseconds)
+#define FLAME_STABLE_TIME 10000 // Flame loss before this counts as unstable ignition (ms)
+#define MAX_TRIALS        3     // Maximum ignition trials before lockout
+#define METRICS_EXPORT_MS 60000 // Metrics snapshot period
+// Ignition trial and retry delay limits are in ignition.h
+
+// Global variables
+volatile SystemState currentState = STATE_IDLE;
+volatile uint8_t ignitionTrials = 0;
+volatile uint8_t lockoutReason = LOCKOUT_NONE;
+
+// Thermostat/BMS inputs and telemetry (I2C register map)
+uint8_t busHeatDemand = 0;
+uint8_t busFiringRate = 0;            // 0 = use potentiometer
+int16_t targetTemp = 2000;            // 20.00°C
+uint8_t valvePercent = 0;
+
+// Digital thermostat link on the heat request pin (thermostat.h)
+uint8_t thermostatMode = THERMOSTAT_MODE_DEFAULT;
+ThermostatFrame thermostat = { 0, 0, 0 };
+uint32_t thermostatFrameMs = 0;       // Uptime of the last valid frame
+
+// Latched from ISR events so short presses are not missed between loops
+uint8_t heatRequestPending = 0;
+uint8_t safetyTripPending = 0;
+uint32_t uptimeMs = 0;
+uint16_t loopElapsedMs = 0;           // Milliseconds covered by this pass
+uint32_t heatRequestMs = 0;           // Uptime when the heat call started
+static uint16_t stateTimer = 0;       // Milliseconds in current state
+RamBudget ramBudget;                  // SRAM left after RAMFUNC placement
+
+// Peripheral state left by the full init path, written in one pass on
+// fast boot. Values assume register reset defaults; ports are written
+// as 16-bit pairs so each pair costs one store.
+static const RegImage bootImage[] = {
+    // Port A = P1 (low byte) + P2 (high byte). P1: A3/A4/A5 analog,
+    // P1.0 red LED, P1.3/P1.4 pilot, P1.6 spark driver (TB0.1, stopped).
+    // P2: P2.0 valve PWM, P2.3 safety switch
+    { &PAOUT,    (SAFETY_SWITCH_PIN << 8) },
+    { &PADIR,    STATUS_RED_PIN | BIT3 | BIT4 | IGNITER_SPARK_PIN | (MAIN_VALVE_PWM_PIN << 8) },
+    { &PASEL0,   BIT3 | BIT4 | BIT5 | (MAIN_VALVE_PWM_PIN << 8) },
+    { &PASEL1,   BIT3 | BIT4 | BIT5 | IGNITER_SPARK_PIN },
+    { &PAREN,    (SAFETY_SWITCH_PIN << 8) },
+    { &PAIES,    (SAFETY_SWITCH_PIN << 8) },
+    { &PAIFG,    0 },
+    { &PAIE,     (SAFETY_SWITCH_PIN << 8) },
+    // Port B = P3 + P4. P4.1 heat request with pull-up
+    { &PBOUT,    (HEAT_REQUEST_PIN << 8) },
+    { &PBREN,    (HEAT_REQUEST_PIN << 8) },
+    { &PBIES,    (HEAT_REQUEST_PIN << 8) },
+    { &PBIFG,    0 },
+    { &PBIE,     (HEAT_REQUEST_PIN << 8) },
+    { &PBSEL0,   (I2C_TARGET_PINS << 8) },
+    // Port C = P5 + P6. Igniter and green LED outputs, off. P6.0-P6.2
+    // RGB status LED on Timer_B3
+    { &PCOUT,    0 },
+    { &PCDIR,    IGNITER_LED_PIN | ((STATUS_GREEN_PIN | STATUS_RGB_PINS) << 8) },
+    { &PCSEL0,   (STATUS_RGB_PINS << 8) },
+    // ADC: 12-bit, sampling timer, conversion-complete interrupt
+    { &ADCCTL0,  ADCSHT_8 },
+    { &ADCCTL1,  ADCSHP },
+    { &ADCCTL2,  ADCRES_2 },
+    { &ADCMCTL0, ADCINCH_4 },
+    { &ADCIE,    ADCIE0 },
+    { &ADCCTL0,  ADCSHT_8 | ADCON },
+    // Timer_B1: main valve PWM, closed, no ramp running; widths latch
+    // at the period start as in MainValve_Init()
+    { &TB1CCR0,  MAIN_VALVE_PWM_PERIOD },
+    { &TB1CCTL0, 0 },
+    { &TB1CCTL1, OUTMOD_7 | CLLD_1 },
+    { &TB1CCR1,  MAIN_VALVE_MIN_FLOW },
+    { &TB1CTL,   TBSSEL__SMCLK | MC__UP | TBCLR },
+    // Timer_B3: RGB status PWM, dark until the first pattern
+    { &TB3CCR0,  STATUS_PWM_PERIOD - 1 },
+    { &TB3CCTL1, OUTMOD_7 | CLLD_1 },
+    { &TB3CCTL2, OUTMOD_7 | CLLD_1 },
+    { &TB3CCTL3, OUTMOD_7 | CLLD_1 },
+    { &TB3CTL,   TBSSEL__ACLK | MC__UP | TBCLR },
+    // eUSCI_B1: I2C target, configured while held in reset
+    { &UCB1CTLW0,  UCSWRST | UCMODE_3 | UCSYNC },
+    { &UCB1I2COA0, I2C_TARGET_ADDRESS | UCOAEN },
+    { &UCB1CTLW0,  UCMODE_3 | UCSYNC },
+    { &UCB1IE,     UCRXIE0 | UCTXIE0 | UCSTTIE | UCSTPIE },
+    // Timer_A0: tickless time base on ACLK, no deadline armed; CCR1
+    // timestamps thermostat link edges
+    { &TA0CCTL0, 0 },
+    { &TA0CCTL1, CM_3 | CCIS_2 | CAP },
+    { &TA0CTL,   TASSEL__ACLK | MC__CONTINUOUS | TACLR | TAIE },
+};
+
+// Function prototypes
+void initSystem(void);
+void initPeripherals(void);
+void processEvents(void);
+void processState(void);
+void updateOutputs(void);
+void updateRegisterMap(void);
+void updateMetrics(void);
+void updateHistory(void);
+void runSelfTest(void);
+uint8_t getFiringRate(void);
+uint8_t heatDemanded(void);
+void delay_ms(uint16_t ms);
+void setStatusLED(uint8_t green, uint8_t red);
+
+int main(void) {
+    // Stop watchdog timer
+    WDTCTL = WDTPW | WDTHOLD;
+    
+    // Initialize system
+    initSystem();
+    
+    // Main loop
+    while (1) {
+        Metrics_LoopStart();
+        
+        // Drain events posted by ISRs since the last pass
+        processEvents();
+        
+        // Process current state
+        processState();
+        
+        // Update physical outputs
+        updateOutputs();
+        
+        // Exchange state with the thermostat/BMS bus
+        updateRegisterMap();
+        
+        // Gauges and periodic metrics export
+        updateMetrics();
+        
+        // Sensor history for incident review
+        updateHistory();
+        
+        // One bounded step of the background memory self-test
+        runSelfTest();
+        
+        // Small delay for debouncing and stability
+        delay_ms(10);
+    }
+}
+
+void initSystem(void) {
+    if (Boot_FastPathValid()) {
+        // Fast boot: the last full init completed with this firmware, so
+        // replay its end state instead of re-running every subsystem init
+        Boot_ApplyImage(bootImage, sizeof(bootImage) / sizeof(bootImage[0]));
+        
+        // Disable the GPIO power-on default high-impedance mode
+        PM5CTL0 &= ~LOCKLPM5;
+    } else {
+        // Disable the GPIO power-on default high-impedance mode
+        PM5CTL0 &= ~LOCKLPM5;
+        
+        initPeripherals();
+        Boot_FullInitDone();
+    }
+    
+    // Report SRAM left for code and data after RAMFUNC placement
+    RamFunc_Budget(&ramBudget);
+    
+    // Validated configuration and calibration from FRAM
+    Ignition_Init();            // Learned ignition timing
+    MainValve_LoadCalibration(); // Valve flow curve
+    History_Init(bootRecord.resets); // Resume the sensor history log
+    SelfTest_Init();            // CRC references and SRAM bounds
+    
+    // Thermocouple through the SAC0 PGA; also sets the detector levels,
+    // so it runs on the fast boot path too
+    Thermocouple_SetGain(TC_GAIN_DEFAULT);
+    
+    // Enable global interrupts
+    __enable_interrupt();
+    
+    // Initial state
+    currentState = STATE_IDLE;
+    setStatusLED(1, 0);  // Green on, Red off in idle
+}
+
+void initPeripherals(void) {
+    // Initialize subsystems
+    initADC();              // Initialize ADC
+    Thermocouple_Init();    // Initialize thermocouple
+    thermistor_InitADC();   // Initialize thermistor
+    Pilot_Init();           // Initialize pilot valve
+    Igniter_Init();         // Initialize igniter
+    MainValve_Init();       // Initialize main valve
+    Pot_Init();             // Initialize potentiometer
+    Status_Init();          // Initialize RGB status indicator
+    I2CTarget_Init();       // Initialize thermostat/BMS I2C target
+    
+    // Configure heat request input pin (P4.1)
+    P4DIR &= ~HEAT_REQUEST_PIN;   // Input
+    P4REN |= HEAT_REQUEST_PIN;    // Enable pull-up/down
+    P4OUT |= HEAT_REQUEST_PIN;    // Pull-up
+    P4IES |= HEAT_REQUEST_PIN;    // High to low transition
+    P4IE |= HEAT_REQUEST_PIN;     // Enable interrupt
+    P4IFG &= ~HEAT_REQUEST_PIN;   // Clear interrupt flag
+    
+    // Configure safety switch input (P2.3)
+    P2DIR &= ~SAFETY_SWITCH_PIN;  // Input
+    P2REN |= SAFETY_SWITCH_PIN;   // Enable pull-up/down
+    P2OUT |= SAFETY_SWITCH_PIN;   // Pull-up
+    P2IES |= SAFETY_SWITCH_PIN;   // High to low transition
+    P2IE |= SAFETY_SWITCH_PIN;    // Enable interrupt
+    P2IFG &= ~SAFETY_SWITCH_PIN;  // Clear interrupt flag
+    
+    // Configure status LEDs
+    P6DIR |= STATUS_GREEN_PIN;    // Output
+    P1DIR |= STATUS_RED_PIN;      // Output
+    P6OUT &= ~STATUS_GREEN_PIN;   // Initially off
+    P1OUT &= ~STATUS_RED_PIN;     // Initially off
+    
+    // Tickless time base on Timer_A0
+    Time_Init();
+    Thermostat_Init();
+}
+
+void processEvents(void) {
+    Event event;
+    
+    while (Event_Get(&eventQueue, &event)) {
+        switch (event.type) {
+            case EVENT_HEAT_REQUEST:
+                if (event.arg8) heatRequestPending = 1;
+                break;
+                
+            case EVENT_SAFETY_SWITCH:
+                if (event.arg8) safetyTripPending = 1;
+                break;
+                
+            case EVENT_THERMOSTAT_FRAME:
+                thermostat.heatDemand = (event.arg8 & THERMOSTAT_FLAG_HEAT) ? 1 : 0;
+                thermostat.setpoint = (uint8_t)event.arg16;
+                thermostat.modulation = (uint8_t)(event.arg16 >> 8);
+                thermostatFrameMs = uptimeMs;
+                targetTemp = (int16_t)thermostat.setpoint * 50;
+                break;
+                
+            default:
+                break;
+        }
+    }
+    
+    // Time comes straight from the free-running timer, no tick events
+    loopElapsedMs = Time_TakeElapsedMs();
+    uptimeMs += loopElapsedMs;
+    
+    // The time since the last pass was spent in the state set back then
+    Metrics_StateTime(currentState, loopElapsedMs);
+    Metrics_ValveFlow(valvePercent, loopElapsedMs);
+}
+
+RAMFUNC void processState(void) {
+    static uint16_t purgeTime = PREPURGE_TIME;
+    static uint8_t flameStable = 0;
+    uint8_t flameDetected = 0;
+    uint8_t heatDemand;
+    
+    // Raw request shaped by minimum burn/off times and gap merging (demand.c).
+    // A latched press counts for this pass only: a request that is still
+    // there is on the pin next pass, one withdrawn while demand.c holds
+    // off the next ignition is dropped rather than starting a full burn.
+    heatDemand = Demand_Update(heatDemanded() || heatRequestPending, currentState, loopElapsedMs);
+    heatRequestPending = 0;
+    
+    // Sample what this state's plan calls for (sampling.c)
+    if (Sampling_Run(currentState, loopElapsedMs) & (1 << SAMPLE_FLAME)) {
+        Boot_FirstFlameSample();    // Records reset-to-supervision time once
+    }
+    flameDetected = sensorSamples.flame;
+    
+    // Process based on current state
+    switch (currentState) {
+        case STATE_IDLE:
+            // Check if heat is requested (or was pressed since last pass)
+            if (heatDemand) {
+                currentState = STATE_PREPURGE;
+                stateTimer = 0;
+                ignitionTrials = 0;
+                purgeTime = PREPURGE_TIME;
+                heatRequestMs = uptimeMs;
+                Metrics_Count(METRIC_HEAT_CYCLES);
+                setStatusLED(0, 1);  // Green off, Red on during sequence
+            }
+            break;
+            
+        case STATE_PREPURGE:
+            // Wait for prepurge time (longer after a failed trial)
+            if (stateTimer >= purgeTime) {
+                currentState = STATE_PILOT_IGNITION;
+                stateTimer = 0;
+                
+                // Open pilot valve and start ignition; spark train on
+                // Timer_B0, faster on later trials
+                ignitionTrials++;
+                outputs.pilot = 1;
+                outputs.igniterTrial = ignitionTrials;
+            }
+            break;
+            
+        case STATE_PILOT_IGNITION:
+            // Check if flame is detected
+            if (flameDetected) {
+                Ignition_RecordFlame(stateTimer);
+                currentState = STATE_PILOT_PROVE;
+                stateTimer = 0;
+                // Turn off igniter
+                outputs.igniterTrial = 0;
+            }
+            
+            // Check for timeout (learned limit, never above IGNITION_TRIAL_MAX)
+            if (stateTimer >= Ignition_TrialTime(ignitionTrials)) {
+                // Turn off igniter and close pilot valve
+                outputs.igniterTrial = 0;
+                outputs.pilot = 0;
+                
+                Ignition_RecordFailure();
+                
+                // Check if we've reached max trials
+                if (ignitionTrials >= MAX_TRIALS) {
+                    currentState = STATE_LOCKOUT;
+                    lockoutReason = LOCKOUT_IGNITION_FAILED;
+                    Metrics_Count(METRIC_LOCKOUTS);
+                } else {
+                    // Wait before retry, scaled to the gas just released;
+                    // the loop keeps running so the closed pilot is
+                    // committed straight away
+                    Metrics_Count(METRIC_IGNITION_RETRIES);
+                    purgeTime = PREPURGE_TIME + Ignition_RetryDelay(stateTimer);
+                    stateTimer = 0;
+                    currentState = STATE_PREPURGE;
+                }
+            }
+            break;
+            
+        case STATE_PILOT_PROVE:
+            // Verify flame stability for a short period
+            if (!flameDetected) {
+                // Flame lost during prove period
+                Ignition_RecordFlameLoss();
+                currentState = STATE_SHUTDOWN;
+                stateTimer = 0;
+            } else if (stateTimer >= FLAME_PROVE_TIME && Thermocouple_FlameConfirmed()) {
+                // Flame proven stable and past the absolute threshold (a
+                // slope-only flame gets FLAME_CONFIRM_SAMPLES to get
+                // there, else the detector drops it), open main valve
+                currentState = STATE_MAIN_VALVE;
+                stateTimer = 0;
+                flameStable = 0;
+                Ignition_RecordLatency(FX_SatU16(uptimeMs - heatRequestMs));
+                
+                // Set main valve flow from the bus or potentiometer
+                outputs.valvePercent = getFiringRate();
+                
+                // Set status LED to indicate heat active
+                setStatusLED(1, 1);  // Both LEDs on during heating
+            }
+            break;
+            
+        case STATE_MAIN_VALVE:
+            // Normal operation - monitor flame and controls
+            
+            // Update valve position from the bus or potentiometer; a
+            // commissioning sweep (main_valve.c) overrides it while running
+            outputs.valvePercent = getFiringRate();
+            outputs.valvePulse = MainValve_CommissionStep(loopElapsedMs);
+            
+            // Check if flame is lost
+            if (stateTimer >= FLAME_STABLE_TIME) flameStable = 1;
+            if (!flameDetected) {
+                if (!flameStable) Ignition_RecordFlameLoss();
+                currentState = STATE_SHUTDOWN;
+                stateTimer = 0;
+            } else if (!heatDemand) {
+                // Heat request removed: keep the pilot for a quick relight,
+                // or shut down
+                if (demandConfig.pilotHoldMs) {
+                    currentState = STATE_PILOT_HOLD;
+                    outputs.valvePercent = 0;
+                } else {
+                    currentState = STATE_SHUTDOWN;
+                }
+                stateTimer = 0;
+            }
+            break;
+            
+        case STATE_PILOT_HOLD:
+            // Main valve closed, pilot still supervised
+            if (!flameDetected) {
+                currentState = STATE_SHUTDOWN;
+                stateTimer = 0;
+            } else if (heatDemand) {
+                // Demand back within the hold: no prepurge or ignition
+                currentState = STATE_MAIN_VALVE;
+                stateTimer = 0;
+                Metrics_Count(METRIC_PILOT_REUSES);
+                outputs.valvePercent = getFiringRate();
+                setStatusLED(1, 1);  // Both LEDs on during heating
+            } else if (stateTimer >= demandConfig.pilotHoldMs) {
+                currentState = STATE_SHUTDOWN;
+                stateTimer = 0;
+            }
+            break;
+            
+        case STATE_SHUTDOWN:
+            // Igniter off if the sequence was cut short, close main
+            // valve immediately
+            outputs.igniterTrial = 0;
+            outputs.valvePercent = 0;
+            
+            // Keep pilot valve open briefly to ensure clean shutdown
+            if (stateTimer >= 1000) {  // 1 second delay
+                outputs.pilot = 0;
+                currentState = STATE_IDLE;
+                stateTimer = 0;
+                
+                // Return to idle state indicators
+                setStatusLED(1, 0);  // Green on, Red off
+            }
+            break;
+            
+        case STATE_LOCKOUT:
+            // Lockout state - all valves closed, requires manual reset
+            outputs.igniterTrial = 0;
+            outputs.pilot = 0;
+            outputs.valvePercent = 0;
+            
+            // Lockout blink runs on Timer_B3 (see status_led.c)
+            
+            // Check for reset (both buttons pressed); self-test faults
+            // stay latched until a power cycle
+            if (lockoutReason != LOCKOUT_SELFTEST_CRC && lockoutReason != LOCKOUT_SELFTEST_RAM &&
+                !(P4IN & HEAT_REQUEST_PIN) && !(P2IN & SAFETY_SWITCH_PIN)) {
+                delay_ms(1000);  // Debounce and confirm
+                if (!(P4IN & HEAT_REQUEST_PIN) && !(P2IN & SAFETY_SWITCH_PIN)) {
+                    currentState = STATE_IDLE;
+                    lockoutReason = LOCKOUT_NONE;
+                    stateTimer = 0;
+                    setStatusLED(1, 0);  // Green on, Red off
+                }
+            }
+            break;
+    }
+    
+    // A sweep needs steady flame on the main valve; anything else ends it
+    if (currentState != STATE_MAIN_VALVE) {
+        MainValve_CommissionAbort();
+        outputs.valvePulse = 0;
+    }
+    
+    // Update state timer
+    stateTimer += loopElapsedMs;
+}
+
+void updateOutputs(void) {
+    static uint8_t shownState = STATE_COUNT;
+    uint8_t tripped = 0;
+    
+    // Safety check: if safety switch is triggered, force shutdown. Gas
+    // and spark come off in the image itself, so SHUTDOWN cannot reopen
+    // the pilot on a later pass.
+    if (!(P2IN & SAFETY_SWITCH_PIN) || safetyTripPending) {
+        safetyTripPending = 0;
+        tripped = 1;
+        outputs.pilot = 0;
+        outputs.igniterTrial = 0;
+        outputs.valvePercent = 0;
+        outputs.valvePulse = 0;
+        if (currentState != STATE_LOCKOUT && currentState != STATE_IDLE) {
+            currentState = STATE_SHUTDOWN;
+            stateTimer = 0;
+        }
+    }
+    
+    // Status indicator only needs touching when the state changes
+    if (currentState != shownState) {
+        shownState = currentState;
+        Status_Show(shownState);
+    }
+    
+    // Apply this pass's actuator image, gas cut at once on a trip
+    Output_Commit(currentState, tripped);
+    valvePercent = Output_Applied()->valvePercent;
+}
+
+uint8_t heatDemanded(void) {
+    if (busHeatDemand) return 1;
+    
+    if (thermostatMode == THERMOSTAT_DIGITAL) {
+        // Fail safe: demand lapses if valid frames stop arriving
+        return thermostat.heatDemand && (uptimeMs - thermostatFrameMs < THERMOSTAT_TIMEOUT_MS);
+    }
+    return !(P4IN & HEAT_REQUEST_PIN);
+}
+
+uint8_t getFiringRate(void) {
+    // A rate written over the bus overrides the thermostat's modulation
+    // request, which overrides the local potentiometer
+    if (busFiringRate) {
+        valvePercent = busFiringRate;
+    } else if (thermostatMode == THERMOSTAT_DIGITAL && thermostat.modulation) {
+        valvePercent = thermostat.modulation;
+    } else {
+        valvePercent = sensorSamples.potPercent;
+    }
+    if (valvePercent > 100) valvePercent = 100;
+    return valvePercent;
+}
+
+void updateRegisterMap(void) {
+    RegisterWrites writes;
+    RegisterMap map;
+    
+    // Apply what the master wrote since the last pass
+    if (I2CTarget_TakeWrites(&writes)) {
+        if (writes.mask & (1U << REG_HEAT_DEMAND)) busHeatDemand = writes.heatDemand ? 1 : 0;
+        if (writes.mask & (1U << REG_FIRING_RATE)) busFiringRate = writes.firingRate;
+        if ((writes.mask & (3U << REG_TARGET_TEMP)) == (3U << REG_TARGET_TEMP)) {
+            targetTemp = writes.targetTemp;     // Both bytes or nothing
+        }
+    }
+    
+    map.version = REGMAP_VERSION;
+    map.state = currentState;
+    map.heatDemand = busHeatDemand;
+    map.firingRate = busFiringRate;
+    map.targetTemp = targetTemp;
+    map.roomTemp = sensorSamples.roomTemp;
+    map.flameSignal = filteredValue;
+    map.valvePercent = valvePercent;
+    map.lockoutReason = lockoutReason;
+    map.ignitions = ignitionParams.ignitions;
+    map.failures = ignitionParams.failures;
+    map.flameLosses = ignitionParams.flameLosses;
+    I2CTarget_Publish(&map);
+}
+
+void updateMetrics(void) {
+    static uint32_t lastExportMs = 0;
+    
+    Metrics_SetGauge(METRIC_VALVE_PERCENT, valvePercent);
+    Metrics_SetGauge(METRIC_ROOM_TEMP, sensorSamples.roomTemp);
+    Metrics_SetGauge(METRIC_FLAME_SIGNAL, filteredValue);
+    Metrics_SetGauge(METRIC_CRC_CYCLE_MS, FX_SatS16(selfTestStats.crcCycleMs));
+    Metrics_SetGauge(METRIC_RAM_CYCLE_MS, FX_SatS16(selfTestStats.ramCycleMs));
+    
+    if (uptimeMs - lastExportMs >= METRICS_EXPORT_MS) {
+        lastExportMs = uptimeMs;
+        Metrics_Export();
+    }
+}
+
+void runSelfTest(void) {
+    uint8_t fault = SelfTest_Step();
+    
+    if (fault != LOCKOUT_NONE && currentState != STATE_LOCKOUT) {
+        currentState = STATE_LOCKOUT;
+        lockoutReason = fault;
+        Metrics_Count(METRIC_LOCKOUTS);
+    }
+}
+
+void updateHistory(void) {
+    static uint32_t lastSampleMs = 0;
+    
+    if (uptimeMs - lastSampleMs >= HISTORY_PERIOD_MS) {
+        lastSampleMs = uptimeMs;
+        History_Record(uptimeMs / 1000, filteredValue, sensorSamples.roomTemp, valvePercent);
+    }
+}
+
+void setStatusLED(uint8_t green, uint8_t red) {
+    // Committed with the actuators at the end of the pass
+    outputs.greenLED = green;
+    outputs.redLED = red;
+}
+
+void delay_ms(uint16_t ms) {
+    uint32_t start = Time_Now();
+    
+    Metrics_IdleBegin();
+    // Sleep in LPM0 until the deadline instead of counting 1ms ticks
+    Time_Arm(TIME_DEADLINE_DELAY, start + TIME_MS_TO_TICKS(ms));
+    if (!Time_Sleep(TIME_DEADLINE_DELAY)) {
+        // Woken early by a flame sample block: idle only as long as slept
+        ms = (uint16_t)(((Time_Now() - start) * 1000) / TIME_TICKS_PER_SEC);
+    }
+    Metrics_IdleEnd(ms);
+}
+
+// Button 1 interrupt (heat request)
+#pragma vector=PORT4_VECTOR
+RAMFUNC __interrupt void Port_4_ISR(void) {
+    if (P4IFG & HEAT_REQUEST_PIN) {
+        // Falling edge (IES set) means the active-low request asserted
+        uint8_t low = (P4IES & HEAT_REQUEST_PIN) ? 1 : 0;
+        
+        // Toggle interrupt edge
+        P4IES ^= HEAT_REQUEST_PIN;
+        
+        P4IFG &= ~HEAT_REQUEST_PIN;  // Clear interrupt flag
+        
+        if (thermostatMode == THERMOSTAT_DIGITAL) {
+            Thermostat_Edge(!low);   // Manchester link edge
+        } else {
+            Event_Post(&eventQueue, EVENT_HEAT_REQUEST, low, 0);
+        }
+    }
+}
+
+// Button 2 interrupt (safety switch)
+#pragma vector=PORT2_VECTOR
+RAMFUNC __interrupt void Port_2_ISR(void) {
+    if (P2IFG & SAFETY_SWITCH_PIN) {
+        Event_Post(&eventQueue, EVENT_SAFETY_SWITCH, (P2IES & SAFETY_SWITCH_PIN) ? 1 : 0, 0);
+        
+        // Toggle interrupt edge
+        P2IES ^= SAFETY_SWITCH_PIN;
+        
+        P2IFG &= ~SAFETY_SWITCH_PIN;  // Clear interrupt flag
+    }
 }
\ No newline at end of file
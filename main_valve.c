@@ -1,29 +1,247 @@
-#include "main_valve.h"
-#include <msp430.h>
-
-void MainValve_Init(void) {
-    // Configure PWM pin
-    P2DIR |= MAIN_VALVE_PWM_PIN;
-    P2SEL0 |= MAIN_VALVE_PWM_PIN;      // Select TB1.1 function
-    P2SEL1 &= ~MAIN_VALVE_PWM_PIN;
-    
-    // Timer_B1 configuration
-    TB1CCR0 = MAIN_VALVE_PWM_PERIOD;    // 20ms period
-    TB1CCTL1 = OUTMOD_7;                // Reset/set output mode
-    TB1CTL = TBSSEL__SMCLK | MC__UP | TBCLR; // SMCLK, up mode
-    
-    // Start with valve closed
-    TB1CCR1 = MAIN_VALVE_MIN_FLOW;
-}
-
-void MainValve_Set(uint8_t flow_percent) {
-    // Constrain input to 0-100%
-    if(flow_percent > 100) flow_percent = 100;
-    
-    // Calculate pulse width (linear 1-2ms)
-    uint16_t pulse_width = MAIN_VALVE_MIN_FLOW + 
-                          ((MAIN_VALVE_MAX_FLOW - MAIN_VALVE_MIN_FLOW) * flow_percent) / 100;
-    
-    // Update PWM duty cycle
-    TB1CCR1 = pulse_width;
-}
\ No newline at end of file
+#include "main_valve.h"
+#include "fram.h"
+#include "fixmath.h"
+#include <msp430.h>
+
+#define VALVE_CAL_MAGIC   0xCA1B
+#define VALVE_CAL_STEP    ((MAIN_VALVE_MAX_FLOW - MAIN_VALVE_MIN_FLOW) / (VALVE_CAL_POINTS - 1))
+
+#pragma PERSISTENT(valveCalibration)
+ValveCalibration valveCalibration = { 0 };
+
+// Inverse curve: pulse width for each flow percent, rebuilt whenever the
+// calibration changes so MainValve_Set() is a single lookup. Always
+// rebuilt before use, so it is kept out of C startup zero-init.
+#pragma NOINIT(flowToPulse)
+static uint16_t flowToPulse[101];
+
+// Active move, owned by the Timer_B1 CCR0 ISR while CCIE is set
+static uint16_t moveTarget = MAIN_VALVE_MIN_FLOW;   // Pulse reached or heading to
+static uint16_t moveStart;
+static int16_t moveDelta;
+static uint16_t movePhase;           // 0..65535 over the move (Q16)
+static uint16_t movePhaseStep;       // Phase advance per PWM period
+static uint16_t movePeriodsLeft;     // Interrupts until the move lands
+
+// Commissioning sweep, stepped from the main loop (MainValve_CommissionStep)
+static uint16_t (*calMeasure)(void);
+static uint8_t calStatus = VALVE_CAL_IDLE;
+static uint8_t calPoint;
+static uint16_t calSettleMs;
+static uint16_t calRaw[VALVE_CAL_POINTS];
+
+static uint8_t CalibrationValid(const ValveCalibration *cal) {
+    uint8_t i;
+    
+    if (cal->magic != VALVE_CAL_MAGIC) return 0;
+    if (cal->checksum != FRAM_Checksum(cal, sizeof(*cal) - sizeof(cal->checksum))) return 0;
+    
+    // Non-decreasing, and strictly increasing once gas flows: a real
+    // valve passes nothing over the first part of its travel
+    for (i = 1; i < VALVE_CAL_POINTS; i++) {
+        if (cal->flow[i] < cal->flow[i-1]) return 0;
+        if (cal->flow[i] == cal->flow[i-1] && cal->flow[i] != 0) return 0;
+    }
+    return cal->flow[VALVE_CAL_POINTS-1] != 0;
+}
+
+static void BuildInverseTable(const ValveCalibration *cal) {
+    uint8_t percent;
+    uint8_t seg = 0;
+    
+    // Start from the last zero-flow point, the edge of the closed dead band
+    while (seg < VALVE_CAL_POINTS - 2 && cal->flow[seg+1] == 0) seg++;
+    
+    // 0% is the closed end of travel, not the edge of the dead band
+    flowToPulse[0] = MAIN_VALVE_MIN_FLOW;
+    
+    for (percent = 1; percent <= 100; percent++) {
+        uint16_t target = percent * (VALVE_CAL_FULL_SCALE / 100);
+        
+        // Clamp outside the measured range
+        if (target <= cal->flow[seg]) {
+            flowToPulse[percent] = MAIN_VALVE_MIN_FLOW + seg * VALVE_CAL_STEP;
+            continue;
+        }
+        if (target >= cal->flow[VALVE_CAL_POINTS-1]) {
+            flowToPulse[percent] = MAIN_VALVE_MAX_FLOW;
+            continue;
+        }
+        
+        // Targets increase, so the segment only ever moves forward
+        while (target > cal->flow[seg+1]) seg++;
+        
+        // Linear interpolation inside the segment (divide here, not in the hot path)
+        flowToPulse[percent] = MAIN_VALVE_MIN_FLOW + seg * VALVE_CAL_STEP +
+            (uint16_t)((uint32_t)(target - cal->flow[seg]) * VALVE_CAL_STEP /
+                       (cal->flow[seg+1] - cal->flow[seg]));
+    }
+}
+
+static void DefaultCalibration(ValveCalibration *cal) {
+    uint8_t i;
+    
+    // Linear valve: flow proportional to pulse width
+    cal->magic = VALVE_CAL_MAGIC;
+    for (i = 0; i < VALVE_CAL_POINTS; i++) {
+        cal->flow[i] = i * (VALVE_CAL_FULL_SCALE / (VALVE_CAL_POINTS - 1));
+    }
+    cal->checksum = FRAM_Checksum(cal, sizeof(*cal) - sizeof(cal->checksum));
+}
+
+void MainValve_Init(void) {
+    // Configure PWM pin
+    P2DIR |= MAIN_VALVE_PWM_PIN;
+    P2SEL0 |= MAIN_VALVE_PWM_PIN;      // Select TB1.1 function
+    P2SEL1 &= ~MAIN_VALVE_PWM_PIN;
+    
+    // Timer_B1 configuration
+    TB1CCR0 = MAIN_VALVE_PWM_PERIOD;    // 20ms period
+    TB1CCTL0 = 0;                       // No move in progress
+    TB1CCTL1 = OUTMOD_7 | CLLD_1;       // Reset/set, new width latched at period start
+    TB1CTL = TBSSEL__SMCLK | MC__UP | TBCLR; // SMCLK, up mode
+    
+    // Start with valve closed
+    moveTarget = MAIN_VALVE_MIN_FLOW;
+    TB1CCR1 = MAIN_VALVE_MIN_FLOW;
+}
+
+void MainValve_LoadCalibration(void) {
+    // Fall back to a linear curve if this unit was never commissioned
+    if (CalibrationValid(&valveCalibration)) {
+        BuildInverseTable(&valveCalibration);
+    } else {
+        ValveCalibration cal;
+        DefaultCalibration(&cal);
+        BuildInverseTable(&cal);
+    }
+}
+
+// Closing is never profiled: when the interlocks take the valve to 0
+// the gas goes off at the next period, whatever move was in progress
+static void Close(void) {
+    TB1CCTL0 &= ~CCIE;
+    moveTarget = MAIN_VALVE_MIN_FLOW;
+    TB1CCR1 = MAIN_VALVE_MIN_FLOW;
+}
+
+// S-curve move from the current width, advanced once per PWM period by
+// the Timer_B1 CCR0 interrupt. Duration is proportional to distance, a
+// full stroke taking MAIN_VALVE_STROKE_PERIODS.
+static void MoveTo(uint16_t pulse) {
+    uint16_t from, distance, periods;
+    
+    if (pulse == moveTarget) return;
+    
+    // Hold the ISR off while the profile changes under it
+    TB1CCTL0 &= ~CCIE;
+    from = TB1CCR1;
+    distance = (pulse > from) ? pulse - from : from - pulse;
+    periods = (uint16_t)((uint32_t)distance * MAIN_VALVE_STROKE_PERIODS /
+                         (MAIN_VALVE_MAX_FLOW - MAIN_VALVE_MIN_FLOW));
+    if (periods == 0) periods = 1;
+    
+    // The last of 'periods' interrupts lands on target
+    moveTarget = pulse;
+    moveStart = from;
+    moveDelta = (int16_t)(pulse - from);
+    movePhase = 0;
+    movePhaseStep = (uint16_t)(0x10000UL / periods);    // Unused when periods == 1
+    movePeriodsLeft = periods;
+    TB1CCTL0 = CCIE;
+}
+
+// Sets the target only; the valve gets there from the Timer_B1 ISR
+void MainValve_Set(uint8_t flow_percent) {
+    // Constrain input to 0-100%
+    if(flow_percent > 100) flow_percent = 100;
+    
+    if (flow_percent == 0) Close();
+    else MoveTo(flowToPulse[flow_percent]);
+}
+
+void MainValve_SetPulse(uint16_t pulse) {
+    if (pulse > MAIN_VALVE_MAX_FLOW) pulse = MAIN_VALVE_MAX_FLOW;
+    
+    if (pulse <= MAIN_VALVE_MIN_FLOW) Close();
+    else MoveTo(pulse);
+}
+
+// Normalise a finished sweep to full scale and store it if invertible
+static uint8_t StoreCalibration(void) {
+    ValveCalibration cal;
+    uint8_t i;
+    
+    if (calRaw[VALVE_CAL_POINTS-1] == 0) return VALVE_CAL_REJECTED;
+    
+    cal.magic = VALVE_CAL_MAGIC;
+    for (i = 0; i < VALVE_CAL_POINTS; i++) {
+        cal.flow[i] = (uint16_t)((uint32_t)calRaw[i] * VALVE_CAL_FULL_SCALE /
+                                 calRaw[VALVE_CAL_POINTS-1]);
+    }
+    cal.checksum = FRAM_Checksum(&cal, sizeof(cal) - sizeof(cal.checksum));
+    
+    // Reject curves that cannot be inverted
+    if (!CalibrationValid(&cal)) return VALVE_CAL_REJECTED;
+    
+    FRAM_Write(&valveCalibration, &cal, sizeof(cal));
+    BuildInverseTable(&cal);
+    return VALVE_CAL_STORED;
+}
+
+// Arm a sweep of the valve across its pulse range, recording measured
+// flow at each point. measureFlow() returns flow in any linear unit
+// (meter counts, test-rig reading); the curve is normalised to full
+// scale before saving. The sweep starts the next time the burner is in
+// STATE_MAIN_VALVE.
+void MainValve_CommissionStart(uint16_t (*measureFlow)(void)) {
+    calMeasure = measureFlow;
+    calStatus = VALVE_CAL_ARMED;
+}
+
+// Once per loop pass in STATE_MAIN_VALVE. Returns the pulse width to
+// command through the output stage, or 0 when no sweep is running.
+uint16_t MainValve_CommissionStep(uint16_t elapsedMs) {
+    if (calStatus == VALVE_CAL_ARMED) {
+        // This pass commits the first point; settling counts from the next
+        calStatus = VALVE_CAL_RUNNING;
+        calPoint = 0;
+        calSettleMs = 0;
+    } else if (calStatus == VALVE_CAL_RUNNING) {
+        calSettleMs += elapsedMs;
+        if (calSettleMs >= VALVE_CAL_SETTLE_MS) {
+            calRaw[calPoint] = calMeasure();
+            calSettleMs = 0;
+            if (++calPoint == VALVE_CAL_POINTS) {
+                calStatus = StoreCalibration();
+                return 0;
+            }
+        }
+    } else {
+        return 0;
+    }
+    return MAIN_VALVE_MIN_FLOW + calPoint * VALVE_CAL_STEP;
+}
+
+// The burner left STATE_MAIN_VALVE: a running sweep has lost its flow
+void MainValve_CommissionAbort(void) {
+    if (calStatus == VALVE_CAL_RUNNING) calStatus = VALVE_CAL_ABORTED;
+}
+
+uint8_t MainValve_CommissionStatus(void) {
+    return calStatus;
+}
+
+// Timer_B1 CCR0: one profile step per PWM period while a move is active
+#pragma vector=TIMER1_B0_VECTOR
+__interrupt void MainValve_ISR(void) {
+    if (--movePeriodsLeft == 0) {
+        // Final step: land exactly on target and stop interrupting
+        TB1CCR1 = moveTarget;
+        TB1CCTL0 &= ~CCIE;
+        return;
+    }
+    movePhase += movePhaseStep;
+    
+    TB1CCR1 = moveStart + (int16_t)(FX_MulS16(moveDelta, FX_EaseQ15(movePhase)) >> 15);
+}
@@ -1,16 +1,49 @@
-#ifndef MAIN_VALVE_H_
-#define MAIN_VALVE_H_
-
-#include <stdint.h>
-
-// Main Valve Configuration
-#define MAIN_VALVE_PWM_PIN     BIT0       // P2.0 (TB1.1)
-#define MAIN_VALVE_PWM_PERIOD  20000      // 20ms period (standard for flow control)
-#define MAIN_VALVE_MIN_FLOW    1000       // 1ms pulse (5% duty)
-#define MAIN_VALVE_MAX_FLOW    2000       // 2ms pulse (10% duty)
-
-// Function Prototypes
-void MainValve_Init(void);
-void MainValve_Set(uint8_t flow_percent);  // 0-100% flow rate
-
-#endif
\ No newline at end of file
+#ifndef MAIN_VALVE_H_
+#define MAIN_VALVE_H_
+
+#include <stdint.h>
+
+// Main Valve Configuration
+#define MAIN_VALVE_PWM_PIN     BIT0       // P2.0 (TB1.1)
+#define MAIN_VALVE_PWM_PERIOD  20000      // 20ms period (standard for flow control)
+#define MAIN_VALVE_MIN_FLOW    1000       // 1ms pulse (5% duty)
+#define MAIN_VALVE_MAX_FLOW    2000       // 2ms pulse (10% duty)
+#define MAIN_VALVE_PERIOD_MS   20
+#define MAIN_VALVE_STROKE_MS   1000       // Full-stroke move; closing to 0 is immediate
+#define MAIN_VALVE_STROKE_PERIODS  (MAIN_VALVE_STROKE_MS / MAIN_VALVE_PERIOD_MS)
+
+// Flow calibration: measured flow at evenly spaced pulse widths from
+// MAIN_VALVE_MIN_FLOW to MAIN_VALVE_MAX_FLOW, in 0.01% of full flow
+#define VALVE_CAL_POINTS       11         // Every 10% of the pulse span
+#define VALVE_CAL_FULL_SCALE   10000      // 100.00%
+#define VALVE_CAL_SETTLE_MS    2000       // Settle time per step
+
+typedef struct {
+    uint16_t magic;
+    uint16_t flow[VALVE_CAL_POINTS];      // Non-decreasing; repeats only at 0 (dead band)
+    uint16_t checksum;
+} ValveCalibration;
+
+// Commissioning sweep progress (MainValve_CommissionStatus)
+typedef enum {
+    VALVE_CAL_IDLE,
+    VALVE_CAL_ARMED,          // Waiting for STATE_MAIN_VALVE
+    VALVE_CAL_RUNNING,
+    VALVE_CAL_STORED,
+    VALVE_CAL_REJECTED,       // Curve cannot be inverted, old one kept
+    VALVE_CAL_ABORTED         // Burner left STATE_MAIN_VALVE mid-sweep
+} ValveCalStatus;
+
+extern ValveCalibration valveCalibration;
+
+// Function Prototypes
+void MainValve_Init(void);
+void MainValve_LoadCalibration(void);
+void MainValve_Set(uint8_t flow_percent);  // 0-100% flow target; 0 closes at once
+void MainValve_SetPulse(uint16_t pulse);   // Raw pulse target, commissioning only
+void MainValve_CommissionStart(uint16_t (*measureFlow)(void));
+uint16_t MainValve_CommissionStep(uint16_t elapsedMs);  // Pulse to command, 0 = none
+void MainValve_CommissionAbort(void);
+uint8_t MainValve_CommissionStatus(void);
+
+#endif
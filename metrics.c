@@ -0,0 +1,103 @@
+#include "metrics.h"
+#include "ramfunc.h"
+#include <string.h>
+
+#define VALVE_FULL_SECOND  100000UL      // 100% for 1000ms, in percent-ms
+
+static MetricsData metrics;
+static MetricsData exported;             // Last snapshot handed to the sink
+static MetricsSink metricsSink = 0;
+
+static uint16_t segmentStart = 0;        // Start of the current active stretch
+static uint32_t passTicks = 0;           // Active + idle ticks this loop pass
+static uint32_t valveResidual = 0;       // Percent-ms not yet a full second
+
+// Index of the highest set bit plus one, 0 for 0
+static const uint8_t bitLength[16] = { 0, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+
+// Count, Add and Observe are called from the RAMFUNC ISRs, so they run
+// from SRAM too
+RAMFUNC void Metrics_Count(MetricCounter id) {
+    metrics.counters[id]++;
+}
+
+RAMFUNC void Metrics_Add(MetricCounter id, uint32_t amount) {
+    metrics.counters[id] += amount;
+}
+
+void Metrics_SetGauge(MetricGauge id, int16_t value) {
+    metrics.gauges[id] = value;
+}
+
+RAMFUNC void Metrics_Observe(MetricHistogram id, uint16_t value) {
+    uint8_t bucket = 0;
+    
+    if (value >= 0x0100) { value >>= 8; bucket = 8; }
+    if (value >= 0x0010) { value >>= 4; bucket += 4; }
+    bucket += bitLength[value];
+    if (bucket >= METRIC_HIST_BUCKETS) bucket = METRIC_HIST_BUCKETS - 1;
+    
+    if (metrics.histograms[id][bucket] != 0xFFFF) {
+        metrics.histograms[id][bucket]++;
+    }
+}
+
+void Metrics_StateTime(uint8_t state, uint16_t ms) {
+    if (state < STATE_COUNT) metrics.stateMs[state] += ms;
+}
+
+void Metrics_ValveFlow(uint8_t percent, uint16_t ms) {
+    valveResidual += (uint32_t)percent * ms;
+    while (valveResidual >= VALVE_FULL_SECOND) {
+        valveResidual -= VALVE_FULL_SECOND;
+        metrics.counters[METRIC_VALVE_FULL_SECONDS]++;
+    }
+}
+
+// Active time is measured in stretches between delays, so no single
+// timer interval gets near the 524ms wrap of the 16-bit timebase
+void Metrics_LoopStart(void) {
+    uint16_t now = METRICS_NOW();
+    uint16_t active = now - segmentStart;
+    
+    metrics.counters[METRIC_ACTIVE_TICKS] += active;
+    passTicks += active;
+    if (metrics.counters[METRIC_LOOPS]++) {
+        Metrics_Observe(METRIC_LOOP_PERIOD, (passTicks > 0xFFFF) ? 0xFFFF : (uint16_t)passTicks);
+    }
+    passTicks = 0;
+    segmentStart = now;
+}
+
+void Metrics_IdleBegin(void) {
+    uint16_t active = METRICS_NOW() - segmentStart;
+    
+    metrics.counters[METRIC_ACTIVE_TICKS] += active;
+    passTicks += active;
+}
+
+// The delay length is known exactly, so idle time does not depend on
+// the timer wrapping
+void Metrics_IdleEnd(uint16_t ms) {
+    uint32_t idle = (uint32_t)ms * METRICS_TICKS_PER_MS;
+    
+    metrics.counters[METRIC_IDLE_TICKS] += idle;
+    passTicks += idle;
+    segmentStart = METRICS_NOW();
+}
+
+void Metrics_Snapshot(MetricsData *out) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    memcpy(out, &metrics, sizeof(metrics));
+    __set_interrupt_state(gie);
+}
+
+void Metrics_SetSink(MetricsSink sink) {
+    metricsSink = sink;
+}
+
+void Metrics_Export(void) {
+    Metrics_Snapshot(&exported);
+    if (metricsSink) metricsSink(&exported);
+}
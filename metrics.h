@@ -0,0 +1,81 @@
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <stdint.h>
+#include <msp430.h>
+#include "system_state.h"
+
+// Timebase: Timer_B2, free-running at SMCLK/8 since reset (boot.c)
+#define METRICS_NOW()         TB2R
+#define METRICS_TICKS_PER_MS  125        // 8µs per tick
+
+#define METRIC_HIST_BUCKETS   16         // Bucket n holds [2^(n-1), 2^n); the last is open-ended
+
+// Monotonic 32-bit counters. Tick counters wrap after ~9.5 hours, so
+// consumers should difference successive snapshots.
+typedef enum {
+    METRIC_LOOPS,              // Main loop passes
+    METRIC_ACTIVE_TICKS,       // CPU running code (8µs ticks)
+    METRIC_IDLE_TICKS,         // CPU waiting in delay_ms (8µs ticks)
+    METRIC_HEAT_CYCLES,        // IDLE -> PREPURGE transitions
+    METRIC_IGNITION_RETRIES,   // Failed trials that were retried
+    METRIC_LOCKOUTS,           // Entries into STATE_LOCKOUT
+    METRIC_VALVE_FULL_SECONDS, // Valve duty integral, 1 = one second at 100%
+    METRIC_TIMER_WAKEUPS,      // Time base interrupts (deadlines + overflows)
+    METRIC_FLAME_IMPLAUSIBLE,  // Flame-level signal seen with the gas off
+    METRIC_HISTORY_SAMPLES,    // Samples written to the history log
+    METRIC_HISTORY_BYTES,      // FRAM bytes they took (raw = 5 per sample)
+    METRIC_DEMAND_MERGED,      // Request gaps bridged without leaving MAIN_VALVE
+    METRIC_PILOT_REUSES,       // PILOT_HOLD -> MAIN_VALVE relights without ignition
+    METRIC_OUTPUT_INTERLOCKS,  // Commits where an interlock overrode a gas output
+    METRIC_ACQ_MISSED,         // Flame samples lost (late, paused or dropped)
+    METRIC_COUNTER_COUNT
+} MetricCounter;
+
+// Last-value gauges
+typedef enum {
+    METRIC_VALVE_PERCENT,
+    METRIC_ROOM_TEMP,          // 0.01°C
+    METRIC_FLAME_SIGNAL,       // Filtered thermocouple ADC
+    METRIC_CRC_CYCLE_MS,       // Self-test full-coverage times, saturated
+    METRIC_RAM_CYCLE_MS,
+    METRIC_GAUGE_COUNT
+} MetricGauge;
+
+// log2-bucket histograms (8µs ticks)
+typedef enum {
+    METRIC_LOOP_PERIOD,
+    METRIC_ADC_LATENCY,        // readADC() start to result, CPU awake per software sample
+    METRIC_HISTORY_ENCODE,     // History_Record() cost
+    METRIC_FLAME_JITTER,       // |flame sample spacing - 20ms|, either trigger path
+    METRIC_ACQ_SAMPLE_COST,    // CPU time per timer-triggered sample (ISR body)
+    METRIC_HIST_COUNT
+} MetricHistogram;
+
+typedef struct {
+    uint32_t counters[METRIC_COUNTER_COUNT];
+    int16_t gauges[METRIC_GAUGE_COUNT];
+    uint16_t histograms[METRIC_HIST_COUNT][METRIC_HIST_BUCKETS];
+    uint32_t stateMs[STATE_COUNT];   // Time spent in each SystemState
+} MetricsData;
+
+// Receives each exported snapshot (log, bus, FRAM...)
+typedef void (*MetricsSink)(const MetricsData *snapshot);
+
+// Function Prototypes
+void Metrics_Count(MetricCounter id);
+void Metrics_Add(MetricCounter id, uint32_t amount);
+void Metrics_SetGauge(MetricGauge id, int16_t value);
+void Metrics_Observe(MetricHistogram id, uint16_t value);
+void Metrics_StateTime(uint8_t state, uint16_t ms);
+void Metrics_ValveFlow(uint8_t percent, uint16_t ms);
+
+void Metrics_LoopStart(void);
+void Metrics_IdleBegin(void);
+void Metrics_IdleEnd(uint16_t ms);
+
+void Metrics_Snapshot(MetricsData *out);
+void Metrics_SetSink(MetricsSink sink);
+void Metrics_Export(void);
+
+#endif
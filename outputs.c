@@ -0,0 +1,70 @@
+#include "outputs.h"
+#include "igniter.h"
+#include "main_valve.h"
+#include "system_state.h"
+#include "metrics.h"
+#include <msp430.h>
+
+OutputImage outputs = { 0, 0, 0, 0, 0, 0 };
+
+// What was last written; 0xFF forces every output on the first commit
+static OutputImage applied = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFFFF };
+static uint8_t p1Out = 0xFF;
+static uint8_t p5Out = 0xFF;
+static uint8_t p6Out = 0xFF;
+
+// Once per loop pass: interlocks, then one write per port or peripheral
+// whose value changed
+void Output_Commit(uint8_t state, uint8_t tripped) {
+    OutputImage out = outputs;
+    uint8_t p1, p5, p6;
+    
+    // Interlocks act on the committed copy; gas needs a clear safety
+    // switch, the spark needs the pilot in ignition, the main valve
+    // needs the pilot in MAIN_VALVE
+    if (tripped || state == STATE_LOCKOUT) out.pilot = 0;
+    if (!out.pilot || state != STATE_PILOT_IGNITION) out.igniterTrial = 0;
+    if (!out.pilot || state != STATE_MAIN_VALVE) {
+        out.valvePercent = 0;
+        out.valvePulse = 0;
+    }
+    
+    if (out.pilot != outputs.pilot || out.igniterTrial != outputs.igniterTrial ||
+        out.valvePercent != outputs.valvePercent || out.valvePulse != outputs.valvePulse) {
+        Metrics_Count(METRIC_OUTPUT_INTERLOCKS);
+    }
+    
+    p1 = (out.redLED ? STATUS_RED_PIN : 0) |
+         (out.pilot ? (PILOT_VALVE_PIN | HEAT_STATUS_PIN) : 0);
+    p5 = out.igniterTrial ? IGNITER_LED_PIN : 0;
+    p6 = out.greenLED ? STATUS_GREEN_PIN : 0;
+    
+    if (p1 != p1Out) {
+        p1Out = p1;
+        P1OUT = (P1OUT & ~OUTPUT_P1_PINS) | p1;
+    }
+    if (p5 != p5Out) {
+        p5Out = p5;
+        P5OUT = (P5OUT & ~IGNITER_LED_PIN) | p5;
+    }
+    if (p6 != p6Out) {
+        p6Out = p6;
+        P6OUT = (P6OUT & ~STATUS_GREEN_PIN) | p6;
+    }
+    
+    if (out.igniterTrial != applied.igniterTrial) {
+        if (out.igniterTrial) Igniter_Start(out.igniterTrial);
+        else Igniter_Stop();
+    }
+    if (out.valvePulse != applied.valvePulse ||
+        (!out.valvePulse && out.valvePercent != applied.valvePercent)) {
+        if (out.valvePulse) MainValve_SetPulse(out.valvePulse);
+        else MainValve_Set(out.valvePercent);
+    }
+    
+    applied = out;
+}
+
+const OutputImage *Output_Applied(void) {
+    return &applied;
+}
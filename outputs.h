@@ -0,0 +1,33 @@
+#ifndef OUTPUTS_H_
+#define OUTPUTS_H_
+
+#include <stdint.h>
+
+// GPIO actuators and indicators owned by the output stage. PWM and spark
+// outputs are committed through MainValve_Set()/SetPulse() and Igniter_Start/Stop().
+#define STATUS_RED_PIN    BIT0  // P1.0 - Red status LED
+#define PILOT_VALVE_PIN   BIT3  // P1.3 - Pilot valve
+#define HEAT_STATUS_PIN   BIT4  // P1.4 - Heat status, follows the pilot valve
+#define STATUS_GREEN_PIN  BIT6  // P6.6 - Green status LED
+// P5.4 igniter LED: IGNITER_LED_PIN in igniter.h
+
+#define OUTPUT_P1_PINS    (STATUS_RED_PIN | PILOT_VALVE_PIN | HEAT_STATUS_PIN)
+
+// Desired actuator state. The loop writes it freely during a pass and
+// Output_Commit() applies it once, after the interlocks.
+typedef struct {
+    uint8_t pilot;            // Pilot valve open
+    uint8_t igniterTrial;     // 0 = off, else spark profile (igniter.h)
+    uint8_t valvePercent;     // Main valve flow, 0 = closed
+    uint8_t greenLED;
+    uint8_t redLED;
+    uint16_t valvePulse;      // Raw pulse override while commissioning, 0 = none
+} OutputImage;
+
+extern OutputImage outputs;
+
+// Function Prototypes
+void Output_Commit(uint8_t state, uint8_t tripped);   // tripped = safety switch
+const OutputImage *Output_Applied(void);
+
+#endif
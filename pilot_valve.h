@@ -0,0 +1,19 @@
+#ifndef PILOT_VALVE_H_
+#define PILOT_VALVE_H_
+
+#include "outputs.h"
+
+// Direct pilot valve driver on P1.3, with the P1.4 heat status output
+// following it (pins in outputs.h). The controller only uses it to put
+// the pins in a known state at start-up; from then on the output stage
+// owns them.
+
+extern volatile char pilotValveOpen;    // 1 = valve open
+
+// Function Prototypes
+void Pilot_Init(void);                  // Outputs low, valve closed
+void Pilot_Close(void);
+char Pilot_open(void);                  // Toggles; returns the new state
+void Heat_On(void);                     // Opens the valve if closed
+
+#endif
@@ -1,11 +1,12 @@
-#ifndef POTENTIOMETER_H_
-#define POTENTIOMETER_H_
-
-#include <msp430.h>
-#include <stdint.h>
-
-// Function prototypes
-void Pot_Init(void);
-int16_t Pot_Read(void);
-
+#ifndef POTENTIOMETER_H_
+#define POTENTIOMETER_H_
+
+#include <msp430.h>
+#include <stdint.h>
+
+// Function prototypes
+void Pot_Init(void);
+int16_t Pot_Read(void);
+int16_t Pot_AdcToPercent(uint16_t adcValue);
+
 #endif 
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "ramfunc.h"
+
+// Linker-generated symbols (lnk_msp430fr2355.cmd)
+extern char ram_data_start, ram_data_end;
+extern char __STACK_SIZE;
+#if defined(__TI_COMPILER_VERSION__) && (__TI_COMPILER_VERSION__ >= 15009000)
+extern char ramfunc_start, ramfunc_end;
+#endif
+
+void RamFunc_Budget(RamBudget *budget) {
+    uint16_t used;
+    
+#if defined(__TI_COMPILER_VERSION__) && (__TI_COMPILER_VERSION__ >= 15009000)
+    budget->codeBytes = (uint16_t)(&ramfunc_end - &ramfunc_start);
+#else
+    budget->codeBytes = 0;
+#endif
+    budget->dataBytes = (uint16_t)(&ram_data_end - &ram_data_start);
+    budget->stackBytes = (uint16_t)(uintptr_t)&__STACK_SIZE;
+    
+    used = budget->codeBytes + budget->dataBytes + budget->stackBytes;
+    budget->freeBytes = (used < RAM_SIZE) ? RAM_SIZE - used : 0;
+}
@@ -0,0 +1,30 @@
+#ifndef RAMFUNC_H_
+#define RAMFUNC_H_
+
+#include <stdint.h>
+
+// Mark a hot routine to run from SRAM. The linker places it in
+// .TI.ramfunc, which the C startup copies from FRAM to RAM (BINIT table).
+// Above 8MHz MCLK, FRAM fetches need wait states (NWAITS) and SRAM
+// fetches do not; at the default 1MHz there is no difference.
+#if defined(__TI_COMPILER_VERSION__) && (__TI_COMPILER_VERSION__ >= 15009000)
+#define RAMFUNC  __attribute__((ramfunc))
+#else
+#define RAMFUNC
+#endif
+
+#define RAM_START  0x2000            // SRAM origin (lnk_msp430fr2355.cmd)
+#define RAM_SIZE   0x1000            // 4KB SRAM
+
+// SRAM usage, from linker-generated section bounds
+typedef struct {
+    uint16_t codeBytes;              // .TI.ramfunc
+    uint16_t dataBytes;              // .bss + .data + .TI.noinit
+    uint16_t stackBytes;             // Reserved stack
+    uint16_t freeBytes;              // What is left for more RAMFUNCs
+} RamBudget;
+
+// Function Prototypes
+void RamFunc_Budget(RamBudget *budget);
+
+#endif
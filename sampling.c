@@ -0,0 +1,123 @@
+#include "sampling.h"
+#include "system_state.h"
+#include "SENSORS.h"
+#include "thermocouple.h"
+#include "potentiometer.h"
+#include "metrics.h"
+#include "acquire.h"
+#include <msp430.h>
+
+#define FLAME_FAST_MS    FLAME_SAMPLE_MS  // Detector is tuned for one sample per PWM period
+#define FLAME_CHECK_MS   1000   // Plausibility check with the gas off
+#define POT_MS           100
+#define ROOM_MS          1000
+
+// Which channels each state needs, how often, and how they are filtered.
+// Idle and lockout only check that no flame signal is present; the pot
+// is read ahead of the main valve opening so its average is settled.
+static const ChannelPlan samplePlan[STATE_COUNT][SAMPLE_CHANNELS] = {
+    //                          Flame                                  Pot                        Room
+    [STATE_IDLE]           = { { FLAME_CHECK_MS, FILTER_RAW },          { 0, FILTER_RAW },          { ROOM_MS, FILTER_RAW } },
+    [STATE_PREPURGE]       = { { FLAME_FAST_MS,  FILTER_FLAME_DETECT }, { 0, FILTER_RAW },          { ROOM_MS, FILTER_RAW } },
+    [STATE_PILOT_IGNITION] = { { FLAME_FAST_MS,  FILTER_FLAME_DETECT }, { 0, FILTER_RAW },          { ROOM_MS, FILTER_RAW } },
+    [STATE_PILOT_PROVE]    = { { FLAME_FAST_MS,  FILTER_FLAME_DETECT }, { POT_MS, FILTER_EWMA2 },   { ROOM_MS, FILTER_RAW } },
+    [STATE_MAIN_VALVE]     = { { FLAME_FAST_MS,  FILTER_FLAME_DETECT }, { POT_MS, FILTER_EWMA2 },   { ROOM_MS, FILTER_RAW } },
+    [STATE_SHUTDOWN]       = { { FLAME_FAST_MS,  FILTER_FLAME_DETECT }, { 0, FILTER_RAW },          { ROOM_MS, FILTER_RAW } },
+    [STATE_LOCKOUT]        = { { FLAME_CHECK_MS, FILTER_RAW },          { 0, FILTER_RAW },          { ROOM_MS, FILTER_RAW } },
+    [STATE_PILOT_HOLD]     = { { FLAME_FAST_MS,  FILTER_FLAME_DETECT }, { POT_MS, FILTER_EWMA2 },   { ROOM_MS, FILTER_RAW } },
+};
+
+SensorSamples sensorSamples = { 0, 0, 0 };
+uint8_t sampleTrigger = SAMPLE_TRIGGER_DEFAULT;
+
+static uint16_t sinceSample[SAMPLE_CHANNELS];
+static uint16_t potAverage = 0;          // EWMA state, percent << 8
+static uint8_t potSeeded = 0;
+static uint8_t lastState = STATE_COUNT;
+
+// EWMA in 8.8 fixed point; the first sample after a gap seeds it
+static uint8_t FilterPot(uint8_t percent, uint8_t filter) {
+    if (filter != FILTER_EWMA2 || !potSeeded) {
+        potAverage = (uint16_t)percent << 8;
+        potSeeded = 1;
+    } else {
+        potAverage += (int16_t)(((uint16_t)percent << 8) - potAverage) >> 2;
+    }
+    return (uint8_t)((potAverage + 0x80) >> 8);
+}
+
+uint8_t Sampling_Run(uint8_t state, uint16_t elapsedMs) {
+    const ChannelPlan *plan;
+    const AcquireBlock *block;
+    uint8_t due = 0;
+    uint8_t ch;
+    
+    if (state >= STATE_COUNT) return 0;
+    plan = samplePlan[state];
+    
+    // New state: sample everything it needs on this pass
+    if (state != lastState) {
+        lastState = state;
+        for (ch = 0; ch < SAMPLE_CHANNELS; ch++) sinceSample[ch] = 0xFFFF;
+        if (!plan[SAMPLE_POT].periodMs) potSeeded = 0;
+        
+        // Flame detection from timer-triggered conversions if selected;
+        // the ADC then stays powered for the whole state
+        if (plan[SAMPLE_FLAME].filter == FILTER_FLAME_DETECT && sampleTrigger == SAMPLE_TRIGGER_TIMER) {
+            if (!acquireRunning) {
+                enableADC();
+                Acquire_Start(Thermocouple_Channel());
+            }
+        } else {
+            Acquire_Stop();
+        }
+    }
+    
+    // Feed finished blocks through the detector; while lit they are
+    // single samples
+    while (acquireRunning && (block = Acquire_Take()) != 0) {
+        for (ch = 0; ch < block->count; ch++) {
+            sensorSamples.flame = Thermocouple_DetectSample(block->samples[ch]);
+        }
+        Acquire_Release(sensorSamples.flame);
+        due |= (1 << SAMPLE_FLAME);
+    }
+    
+    for (ch = 0; ch < SAMPLE_CHANNELS; ch++) {
+        if (!plan[ch].periodMs) continue;
+        if (ch == SAMPLE_FLAME && acquireRunning) continue;
+        
+        sinceSample[ch] = (sinceSample[ch] > 0xFFFF - elapsedMs) ? 0xFFFF : sinceSample[ch] + elapsedMs;
+        if (sinceSample[ch] >= plan[ch].periodMs) {
+            sinceSample[ch] = 0;
+            due |= (1 << ch);
+        }
+    }
+    
+    if (!due) return 0;
+    
+    enableADC();
+    
+    if ((due & (1 << SAMPLE_FLAME)) && !acquireRunning) {
+        if (plan[SAMPLE_FLAME].filter == FILTER_FLAME_DETECT) {
+            Acquire_ObserveInterval(METRICS_NOW());
+            sensorSamples.flame = Thermocouple_FlameDetected();
+        } else {
+            // Gas is off, so a flame-level signal means a sensor or valve fault
+            sensorSamples.flame = Thermocouple_FlameLevel();
+            if (sensorSamples.flame) Metrics_Count(METRIC_FLAME_IMPLAUSIBLE);
+        }
+    }
+    
+    if (due & (1 << SAMPLE_POT)) {
+        sensorSamples.potPercent = FilterPot((uint8_t)Pot_Read(), plan[SAMPLE_POT].filter);
+    }
+    
+    if (due & (1 << SAMPLE_ROOM)) {
+        sensorSamples.roomTemp = therm_Read();
+    }
+    
+    if (!acquireRunning) disableADC();
+    
+    return due;
+}
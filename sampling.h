@@ -0,0 +1,48 @@
+#ifndef SAMPLING_H_
+#define SAMPLING_H_
+
+#include <stdint.h>
+
+// Per-state sensor sampling plan (table in sampling.c). Each channel is
+// read at most once per period; the ADC is powered only while a pass
+// has something due.
+typedef enum {
+    SAMPLE_FLAME,              // Thermocouple
+    SAMPLE_POT,                // Firing rate potentiometer
+    SAMPLE_ROOM,               // Thermistor
+    SAMPLE_CHANNELS
+} SampleChannel;
+
+typedef enum {
+    FILTER_RAW,                // Single conversion
+    FILTER_EWMA2,              // Exponential average, weight 1/4
+    FILTER_FLAME_DETECT        // Thermocouple moving average + slope detector
+} SampleFilter;
+
+// How FILTER_FLAME_DETECT conversions are started
+typedef enum {
+    SAMPLE_TRIGGER_SOFTWARE,   // readADC() from the loop every FLAME_FAST_MS
+    SAMPLE_TRIGGER_TIMER       // Timer_B1 edges, delivered in blocks (acquire.h)
+} SampleTrigger;
+
+#define SAMPLE_TRIGGER_DEFAULT  SAMPLE_TRIGGER_TIMER
+
+typedef struct {
+    uint16_t periodMs;         // 0 = not sampled in this state
+    uint8_t filter;
+} ChannelPlan;
+
+// Latest values; held between samples
+typedef struct {
+    uint8_t flame;             // Detector output, or raw threshold check
+    uint8_t potPercent;
+    int16_t roomTemp;          // 0.01°C
+} SensorSamples;
+
+extern SensorSamples sensorSamples;
+extern uint8_t sampleTrigger;              // SampleTrigger, read on state changes
+
+// Function Prototypes
+uint8_t Sampling_Run(uint8_t state, uint16_t elapsedMs);   // Returns due-channel mask
+
+#endif
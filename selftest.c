@@ -0,0 +1,199 @@
+#include "selftest.h"
+#include "fram.h"
+#include "metrics.h"
+#include "timebase.h"
+#include "ramfunc.h"
+#include <msp430.h>
+
+#define SELFTEST_MAGIC        0x5E1F
+#define BUDGET_TICKS          (SELFTEST_BUDGET_US / 8)   // METRICS_NOW() ticks
+
+// Linker-generated symbols (lnk_msp430fr2355.cmd)
+extern char fram_rx_start, fram_rx_end;
+extern char __STACK_END, __STACK_SIZE;
+#if defined(__TI_COMPILER_VERSION__) && (__TI_COMPILER_VERSION__ >= 15009000)
+extern char ramfunc_start, ramfunc_end;
+#endif
+
+#define VECTORS_START   0xFF80       // Signatures and interrupt vectors
+#define VECTORS_BYTES   0x0080
+
+typedef enum {
+    REGION_FRAM_RX,            // Init tables, constants, code
+    REGION_VECTORS,
+    REGION_RAMFUNC,            // RAM copy of RAMFUNC code
+    REGION_COUNT
+} CrcRegion;
+
+// Reference CRCs. PERSISTENT data is rewritten on every download, so
+// the first complete pass after flashing records them and later passes
+// compare against them.
+typedef struct {
+    uint16_t magic;
+    uint16_t crc[REGION_COUNT];
+    uint16_t checksum;
+} SelfTestRecord;
+
+#pragma PERSISTENT(selfTestRecord)
+SelfTestRecord selfTestRecord = { 0 };
+
+SelfTestStats selfTestStats;
+
+static SelfTestRecord record;
+static const uint16_t *regionStart[REGION_COUNT];
+static uint16_t regionWords[REGION_COUNT];
+
+static uint8_t region = 0;
+static uint16_t crcOffset = 0;           // Words done in this region
+static uint16_t crcRunning = 0xFFFF;
+static uint16_t crcPassCrc[REGION_COUNT];
+static uint32_t crcPassStart = 0;
+
+static volatile uint16_t *marchPtr;
+static volatile uint16_t *marchEnd;
+static uint32_t ramPassStart = 0;
+
+static uint8_t nextStep = 0;             // 0 = CRC, 1 = March
+static uint8_t fault = LOCKOUT_NONE;     // Latched until reset
+
+static uint32_t TicksToMs(uint32_t ticks) {
+    return (ticks * 125) >> 12;          // * 1000 / 32768
+}
+
+// As downloaded (PERSISTENT zero image) or erased
+static uint8_t RecordBlank(const SelfTestRecord *r) {
+    const uint16_t *w = (const uint16_t *)r;
+    uint8_t i;
+    
+    for (i = 1; i < sizeof(*r) / sizeof(uint16_t); i++) {
+        if (w[i] != w[0]) return 0;
+    }
+    return w[0] == 0x0000 || w[0] == 0xFFFF;
+}
+
+void SelfTest_Init(void) {
+    regionStart[REGION_FRAM_RX] = (const uint16_t *)&fram_rx_start;
+    regionWords[REGION_FRAM_RX] = (uint16_t)(&fram_rx_end - &fram_rx_start) >> 1;
+    regionStart[REGION_VECTORS] = (const uint16_t *)VECTORS_START;
+    regionWords[REGION_VECTORS] = VECTORS_BYTES >> 1;
+#if defined(__TI_COMPILER_VERSION__) && (__TI_COMPILER_VERSION__ >= 15009000)
+    regionStart[REGION_RAMFUNC] = (const uint16_t *)&ramfunc_start;
+    regionWords[REGION_RAMFUNC] = (uint16_t)(&ramfunc_end - &ramfunc_start) >> 1;
+#else
+    regionStart[REGION_RAMFUNC] = 0;
+    regionWords[REGION_RAMFUNC] = 0;
+#endif
+    
+    // SRAM below the stack; the stack holds the March save buffer
+    marchPtr = (volatile uint16_t *)RAM_START;
+    marchEnd = (volatile uint16_t *)(&__STACK_END - (uint16_t)(uintptr_t)&__STACK_SIZE);
+    
+    // Learn only into a record that was never written. One that was
+    // written and no longer checks out is damaged FRAM, not a new image.
+    record = selfTestRecord;
+    if (RecordBlank(&record)) {
+        selfTestStats.learned = 0;
+    } else if (record.magic == SELFTEST_MAGIC &&
+               record.checksum == FRAM_Checksum(&record, sizeof(record) - sizeof(record.checksum))) {
+        selfTestStats.learned = 1;
+    } else {
+        fault = LOCKOUT_SELFTEST_CRC;
+    }
+    
+    crcPassStart = ramPassStart = Time_Now();
+}
+
+// Shares the CRC module with FRAM_Checksum(), so the running value is
+// reloaded as the seed on each step
+static uint8_t CrcStep(void) {
+    uint16_t start = METRICS_NOW();
+    const uint16_t *p = regionStart[region] + crcOffset;
+    uint16_t left = regionWords[region] - crcOffset;
+    uint8_t n;
+    
+    CRCINIRES = crcRunning;
+    while (left) {
+        for (n = (left < SELFTEST_CRC_BURST) ? left : SELFTEST_CRC_BURST; n > 0; n--) {
+            CRCDI = *p++;
+            left--;
+        }
+        if ((uint16_t)(METRICS_NOW() - start) >= BUDGET_TICKS) break;
+    }
+    crcRunning = CRCINIRES;
+    crcOffset = regionWords[region] - left;
+    
+    if (left) return LOCKOUT_NONE;
+    
+    // Region complete
+    crcPassCrc[region] = crcRunning;
+    if (selfTestStats.learned && crcRunning != record.crc[region]) {
+        return LOCKOUT_SELFTEST_CRC;
+    }
+    crcRunning = 0xFFFF;
+    crcOffset = 0;
+    
+    if (++region < REGION_COUNT) return LOCKOUT_NONE;
+    
+    // Pass complete
+    region = 0;
+    if (!selfTestStats.learned) {
+        record.magic = SELFTEST_MAGIC;
+        for (n = 0; n < REGION_COUNT; n++) record.crc[n] = crcPassCrc[n];
+        record.checksum = FRAM_Checksum(&record, sizeof(record) - sizeof(record.checksum));
+        FRAM_Write(&selfTestRecord, &record, sizeof(record));
+        selfTestStats.learned = 1;
+    }
+    
+    uint32_t now = Time_Now();
+    selfTestStats.crcCycleMs = TicksToMs(now - crcPassStart);
+    selfTestStats.crcPasses++;
+    crcPassStart = now;
+    return LOCKOUT_NONE;
+}
+
+// March C- on one block, restoring its contents. Interrupts stay off so
+// nothing reads the block mid-test; the block may hold RAMFUNC code.
+static uint8_t MarchBlock(volatile uint16_t *p, uint8_t n) {
+    uint16_t saved[SELFTEST_MARCH_WORDS];
+    uint8_t ok = 1;
+    uint8_t i;
+    
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    
+    for (i = 0; i < n; i++) saved[i] = p[i];
+    for (i = 0; i < n; i++) p[i] = 0x0000;
+    for (i = 0; i < n; i++) { if (p[i] != 0x0000) ok = 0; p[i] = 0xFFFF; }
+    for (i = 0; i < n; i++) { if (p[i] != 0xFFFF) ok = 0; p[i] = 0x0000; }
+    for (i = n; i > 0; i--) { if (p[i-1] != 0x0000) ok = 0; p[i-1] = 0xFFFF; }
+    for (i = n; i > 0; i--) { if (p[i-1] != 0xFFFF) ok = 0; p[i-1] = 0x0000; }
+    for (i = 0; i < n; i++) { if (p[i] != 0x0000) ok = 0; p[i] = saved[i]; }
+    
+    __set_interrupt_state(gie);
+    return ok;
+}
+
+static uint8_t MarchStep(void) {
+    uint16_t left = (uint16_t)(marchEnd - marchPtr);
+    uint8_t n = (left < SELFTEST_MARCH_WORDS) ? (uint8_t)left : SELFTEST_MARCH_WORDS;
+    
+    if (!MarchBlock(marchPtr, n)) return LOCKOUT_SELFTEST_RAM;
+    
+    marchPtr += n;
+    if (marchPtr >= marchEnd) {
+        uint32_t now = Time_Now();
+        marchPtr = (volatile uint16_t *)RAM_START;
+        selfTestStats.ramCycleMs = TicksToMs(now - ramPassStart);
+        selfTestStats.ramPasses++;
+        ramPassStart = now;
+    }
+    return LOCKOUT_NONE;
+}
+
+uint8_t SelfTest_Step(void) {
+    if (fault != LOCKOUT_NONE) return fault;
+    
+    fault = nextStep ? MarchStep() : CrcStep();
+    nextStep ^= 1;
+    return fault;
+}
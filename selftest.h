@@ -0,0 +1,29 @@
+#ifndef SELFTEST_H_
+#define SELFTEST_H_
+
+#include <stdint.h>
+#include "system_state.h"
+
+// Background self-test, one bounded step per main loop pass. Steps
+// alternate between a CRC16 chunk of code/constant memory and a March
+// C- test of one SRAM block.
+#define SELFTEST_BUDGET_US     400    // CRC step time budget
+#define SELFTEST_CRC_BURST     16     // Words between budget checks
+#define SELFTEST_MARCH_WORDS   8      // SRAM block per March step (interrupts off)
+
+// Coverage, for metrics and the debugger
+typedef struct {
+    uint16_t crcPasses;        // Completed passes over all CRC regions
+    uint16_t ramPasses;        // Completed passes over SRAM
+    uint32_t crcCycleMs;       // Duration of the last full CRC pass
+    uint32_t ramCycleMs;       // Duration of the last full SRAM pass
+    uint8_t learned;           // CRC references recorded for this image
+} SelfTestStats;
+
+extern SelfTestStats selfTestStats;
+
+// Function Prototypes
+void SelfTest_Init(void);
+uint8_t SelfTest_Step(void);   // LOCKOUT_NONE, or the LockoutReason of a fault
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef SERVO_H_
+#define SERVO_H_
+
+#include <stdint.h>
+
+// Servo Configuration (for 16MHz SMCLK with /8 divider)
+#define SERVO_PIN         BIT0       // P2.0 (TB1.1)
+#define PWM_PERIOD        40000      // 20ms period (16MHz/8 = 2MHz → 2000000Hz → 40000 ticks = 20ms)
+#define PWM_PERIOD_MS     20         // Profile advances once per period
+#define MIN_PULSE_WIDTH   1000       // 500μs pulse (1000 ticks at 2MHz), default limit
+#define MAX_PULSE_WIDTH   2000       // 1000μs pulse (2000 ticks at 2MHz), default limit
+#define NEUTRAL_POSITION  1500       // 750μs pulse (1500 ticks)
+
+// Called from the Timer_B1 ISR when a move finishes. The ISR itself
+// wakes the CPU from LPM0 afterwards; the callback must not try to.
+typedef void (*ServoCallback)(void);
+
+// Function Prototypes
+void Servo_Init(void);
+void Servo_SetPosition(unsigned int pulse_us);          // Immediate jump, cancels a move
+uint8_t Servo_Calibrate(unsigned int min_us, unsigned int max_us);  // 1=applied
+uint8_t Servo_MoveTo(unsigned int pulse_us, unsigned int time_ms, ServoCallback done);
+uint8_t Servo_Busy(void);
+void Servo_Stop(void);                                  // Hold current position
+
+#endif
@@ -0,0 +1,44 @@
+#include "spsc_queue.h"
+#include "ramfunc.h"
+
+RAMFUNC uint8_t Queue_Push(SpscQueue *q, const void *item) {
+    uint16_t head = q->head;
+    const uint8_t *src = (const uint8_t *)item;
+    volatile uint8_t *dst;
+    uint8_t i;
+
+    if ((uint16_t)(head - q->tail) > q->mask) return 0;   // Full
+
+    // Fill the slot before publishing the new head
+    dst = q->buffer + (head & q->mask) * q->itemSize;
+    for (i = q->itemSize; i > 0; i--) {
+        *dst++ = *src++;
+    }
+    q->head = head + 1;
+    return 1;
+}
+
+uint8_t Queue_Pop(SpscQueue *q, void *item) {
+    uint16_t tail = q->tail;
+    uint8_t *dst = (uint8_t *)item;
+    volatile uint8_t *src;
+    uint8_t i;
+
+    if (q->head == tail) return 0;                        // Empty
+
+    // Copy the slot out before handing it back to the producer
+    src = q->buffer + (tail & q->mask) * q->itemSize;
+    for (i = q->itemSize; i > 0; i--) {
+        *dst++ = *src++;
+    }
+    q->tail = tail + 1;
+    return 1;
+}
+
+uint16_t Queue_Count(const SpscQueue *q) {
+    return (uint16_t)(q->head - q->tail);
+}
+
+void Queue_Flush(SpscQueue *q) {
+    q->tail = q->head;
+}
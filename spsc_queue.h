@@ -0,0 +1,32 @@
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+#include <stdint.h>
+
+// Lock-free single-producer/single-consumer ring queue.
+// The producer only writes head and the consumer only writes tail; both
+// are 16-bit so every index access is a single MSP430 instruction and
+// neither side needs to disable interrupts. Indices run freely and are
+// masked on access, so capacity must be a power of two.
+typedef struct {
+    volatile uint16_t head;        // Next slot to write (producer)
+    volatile uint16_t tail;        // Next slot to read (consumer)
+    uint16_t mask;                 // Capacity - 1
+    uint8_t itemSize;              // Bytes per item
+    volatile uint8_t *buffer;      // capacity * itemSize bytes
+} SpscQueue;
+
+// Define a statically allocated queue of 'capacity' items of 'type'
+#define SPSC_QUEUE_DEFINE(name, type, capacity)                             \
+    typedef char name##_capacity_is_pow2[((capacity) & ((capacity) - 1)) ? -1 : 1]; \
+    static type name##_storage[capacity];                                   \
+    SpscQueue name = { 0, 0, (capacity) - 1, sizeof(type),                  \
+                       (volatile uint8_t *)name##_storage }
+
+// Function Prototypes
+uint8_t Queue_Push(SpscQueue *q, const void *item);  // 1=queued, 0=full
+uint8_t Queue_Pop(SpscQueue *q, void *item);         // 1=item read, 0=empty
+uint16_t Queue_Count(const SpscQueue *q);
+void Queue_Flush(SpscQueue *q);                      // Consumer side only
+
+#endif
@@ -0,0 +1,131 @@
+#include "status_led.h"
+#include "system_state.h"
+#include <msp430.h>
+
+// Precomputed compare values for one pattern
+typedef struct {
+    uint8_t count;                             // Steps in use
+    uint8_t stepPeriods;                       // PWM periods per step
+    uint8_t duty[STATUS_MAX_STEPS][3];         // R/G/B per step
+} StepTable;
+
+// Colour and pattern for each SystemState
+static const StatusPattern statePatterns[STATE_COUNT] = {
+    /* IDLE           */ {   0, 160,   0, PATTERN_SOLID,    0 },
+    /* PREPURGE       */ { 255, 120,   0, PATTERN_BREATHE,  8 },   // Amber, ~1s cycle
+    /* PILOT_IGNITION */ { 255,  60,   0, PATTERN_BLINK,   13 },   // Orange, ~5Hz
+    /* PILOT_PROVE    */ { 255,  60,   0, PATTERN_BLINK,   32 },   // Orange, 2Hz
+    /* MAIN_VALVE     */ { 255,   0,   0, PATTERN_SOLID,    0 },   // Red, burning
+    /* SHUTDOWN       */ {   0, 160,   0, PATTERN_BREATHE,  4 },   // Green, ~0.5s cycle
+    /* LOCKOUT        */ { 255,   0,   0, PATTERN_BLINK,   32 },   // Red, 250ms on/off
+    /* PILOT_HOLD     */ { 255,  60,   0, PATTERN_SOLID,    0 },   // Orange, pilot only
+};
+
+// Perceptual ramp for breathing (squared), 8 steps up then mirrored
+static const uint8_t breatheRamp[STATUS_MAX_STEPS / 2] = {
+    4, 16, 36, 64, 100, 144, 196, 255
+};
+
+// Double buffer: main fills the idle table, the ISR reads 'active'
+static StepTable tables[2];
+static StepTable * volatile active = &tables[0];
+
+static void LoadStep(const StepTable *table, uint8_t step) {
+    // CLLD_1 latches these at the next period start, so no glitches
+    TB3CCR1 = table->duty[step][0];
+    TB3CCR2 = table->duty[step][1];
+    TB3CCR3 = table->duty[step][2];
+}
+
+void Status_Init(void) {
+    // P6.0-P6.2 to Timer_B3 outputs
+    P6DIR |= STATUS_RGB_PINS;
+    P6SEL0 |= STATUS_RGB_PINS;
+    P6SEL1 &= ~STATUS_RGB_PINS;
+    
+    TB3CCR0 = STATUS_PWM_PERIOD - 1;
+    TB3CCTL1 = OUTMOD_7 | CLLD_1;    // Reset/set, buffered compare
+    TB3CCTL2 = OUTMOD_7 | CLLD_1;
+    TB3CCTL3 = OUTMOD_7 | CLLD_1;
+    TB3CCR1 = 0;
+    TB3CCR2 = 0;
+    TB3CCR3 = 0;
+    TB3CTL = TBSSEL__ACLK | MC__UP | TBCLR;  // ACLK, up mode
+}
+
+void Status_Show(uint8_t state) {
+    if (state >= STATE_COUNT) return;
+    Status_SetPattern(&statePatterns[state]);
+}
+
+void Status_SetPattern(const StatusPattern *pattern) {
+    StepTable *table = (active == &tables[0]) ? &tables[1] : &tables[0];
+    uint8_t i;
+    
+    // Build the step table outside the ISR
+    table->stepPeriods = pattern->stepPeriods;
+    switch (pattern->mode) {
+        case PATTERN_BLINK:
+            table->count = 2;
+            table->duty[0][0] = pattern->red;
+            table->duty[0][1] = pattern->green;
+            table->duty[0][2] = pattern->blue;
+            table->duty[1][0] = 0;
+            table->duty[1][1] = 0;
+            table->duty[1][2] = 0;
+            break;
+            
+        case PATTERN_BREATHE:
+            table->count = STATUS_MAX_STEPS;
+            for (i = 0; i < STATUS_MAX_STEPS; i++) {
+                uint8_t level = breatheRamp[(i < STATUS_MAX_STEPS / 2) ? i : STATUS_MAX_STEPS - 1 - i];
+                table->duty[i][0] = (uint8_t)(((uint16_t)pattern->red * level) >> 8);
+                table->duty[i][1] = (uint8_t)(((uint16_t)pattern->green * level) >> 8);
+                table->duty[i][2] = (uint8_t)(((uint16_t)pattern->blue * level) >> 8);
+            }
+            break;
+            
+        default:
+            table->count = 1;
+            table->duty[0][0] = pattern->red;
+            table->duty[0][1] = pattern->green;
+            table->duty[0][2] = pattern->blue;
+            break;
+    }
+    
+    // Publish, show the first step, and only keep the step interrupt
+    // running for patterns that actually change
+    active = table;
+    LoadStep(table, 0);
+    if (table->count > 1) {
+        TB3CTL |= TBIE;
+    } else {
+        TB3CTL &= ~TBIE;
+    }
+}
+
+// Timer_B3 overflow: once per PWM period, loads compare values only at
+// step boundaries
+#pragma vector=TIMER3_B1_VECTOR
+__interrupt void Timer3_B1_ISR(void) {
+    static const StepTable *table = 0;
+    static uint8_t periods = 0;
+    static uint8_t step = 0;
+    
+    switch(__even_in_range(TB3IV, TB3IV_TBIFG)) {
+        case TB3IV_TBIFG:
+            if (table != active) {
+                // New pattern: step 0 was already loaded by Status_SetPattern
+                table = active;
+                periods = 0;
+                step = 0;
+            }
+            if (++periods < table->stepPeriods) break;
+            periods = 0;
+            if (++step >= table->count) step = 0;
+            LoadStep(table, step);
+            break;
+        default:
+            break;
+    }
+}
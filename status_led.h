@@ -0,0 +1,32 @@
+#ifndef STATUS_LED_H_
+#define STATUS_LED_H_
+
+#include <stdint.h>
+
+// RGB status LED on Timer_B3 compare outputs
+#define STATUS_RGB_PINS     (BIT0 | BIT1 | BIT2)  // P6.0/P6.1/P6.2 = TB3.1/TB3.2/TB3.3 (R/G/B)
+#define STATUS_PWM_PERIOD   256        // ACLK ticks -> 128Hz PWM, 8-bit brightness
+#define STATUS_MAX_STEPS    16         // Steps per pattern
+
+// Pattern modes
+typedef enum {
+    PATTERN_SOLID,        // Fixed colour, no interrupts at all
+    PATTERN_BLINK,        // Colour / off, two steps
+    PATTERN_BREATHE       // Ramp up and down over STATUS_MAX_STEPS steps
+} PatternMode;
+
+// Colour (0-255 per channel) plus timing, stepPeriods in PWM periods (7.8ms)
+typedef struct {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    uint8_t mode;
+    uint8_t stepPeriods;
+} StatusPattern;
+
+// Function Prototypes
+void Status_Init(void);
+void Status_Show(uint8_t state);            // SystemState
+void Status_SetPattern(const StatusPattern *pattern);
+
+#endif
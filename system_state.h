@@ -0,0 +1,31 @@
+#ifndef SYSTEM_STATE_H_
+#define SYSTEM_STATE_H_
+
+#include <stdint.h>
+
+// System state definitions
+typedef enum {
+    STATE_IDLE,           // System idle, waiting for heat request
+    STATE_PREPURGE,       // Pre-purge sequence
+    STATE_PILOT_IGNITION, // Igniting pilot
+    STATE_PILOT_PROVE,    // Verifying pilot flame
+    STATE_MAIN_VALVE,     // Main valve operation
+    STATE_SHUTDOWN,       // Normal shutdown sequence
+    STATE_LOCKOUT,        // Safety shutdown
+    STATE_PILOT_HOLD      // Main valve closed, pilot lit through a demand gap
+} SystemState;
+
+#define STATE_COUNT  (STATE_PILOT_HOLD + 1)
+
+// Why the controller entered STATE_LOCKOUT
+typedef enum {
+    LOCKOUT_NONE,
+    LOCKOUT_IGNITION_FAILED,  // MAX_TRIALS ignition trials without flame
+    LOCKOUT_SELFTEST_CRC,     // Code/constant memory CRC mismatch
+    LOCKOUT_SELFTEST_RAM      // SRAM March test failure
+} LockoutReason;
+
+extern volatile SystemState currentState;
+extern volatile uint8_t lockoutReason;
+
+#endif
@@ -1,44 +1,60 @@
-#include "msp430.h"
-#include "thermistor.h"
-#include <math.h> 
-
-extern char ADCFinished;
-extern unsigned int ADCResult;
-
-static unsigned int readADC(char Channel) {
-    switch(Channel) {
-        case 4: ADCMCTL0 = ADCINCH_4; break; // Only thermistor channel
-        default: ADCMCTL0 = ADCINCH_4; break; // Fallback to thermistor
-    }
-    
-    ADCFinished = 0;
-    ADCCTL0 |= ADCENC | ADCSC;
-    while(ADCFinished != 1);
-    return ADCResult;
-}
-
-void thermistor_InitADC() {
-    // Configure ONLY the thermistor pin (P1.4)
-    P1SEL0 |= BIT4;
-    P1SEL1 |= BIT4;
-
-    // ADC Configuration (matches your style)
-    ADCCTL0 |= ADCSHT_2 | ADCON;
-    ADCCTL1 |= ADCSHP;
-    ADCCTL2 = (ADCCTL2 & ~ADCRES) | ADCRES_2;
-    ADCIE |= ADCIE0;
-}
-
-uint16_t thermistor_ReadTemp() {
-    uint16_t adcValue = readADC(THERMISTOR_ADC_CH);
-    if (adcValue == 0) adcValue = 1; // Avoid division by zero
-
-    // Convert to resistance
-    float resistance = SERIES_RESISTOR * (4095.0f / adcValue - 1.0f);
-
-    // Steinhart-Hart equation 
-    float tempK = 1.0f / (logf(resistance / THERMISTOR_NOMINAL)/THERMISTOR_BETA + 1.0f/(25.0f + 273.15f));
-    float tempC = tempK - 273.15f;
-
-    return (uint16_t)(tempC * 10); // Return as 0.1°C units (e.g., 250 = 25.0°C)
+#include "msp430.h"
+#include "thermistor.h"
+#include "fixmath.h"
+#include "events.h"
+
+// Beta equation in fixed point: 1/T = 1/T0 + ln(R/R0)/B, with
+// R/R0 = (4095 - adc) / adc when the divider resistor equals R0
+#if SERIES_RESISTOR != THERMISTOR_NOMINAL
+#error "thermistor_AdcToTemp assumes SERIES_RESISTOR == THERMISTOR_NOMINAL"
+#endif
+
+#define INV_T0_Q32         14405391L                       // 2^32 / 298.15K
+#define LN2_Q40            762123384786LL                  // ln(2) * 2^40
+#define LN2_OVER_BETA_Q40  ((int32_t)(LN2_Q40 / THERMISTOR_BETA))
+#define KELVIN_OFFSET      27315                           // 273.15K in 0.01 units
+
+static unsigned int readADC(char Channel) {
+    switch(Channel) {
+        case 4: ADCMCTL0 = ADCINCH_4; break; // Only thermistor channel
+        default: ADCMCTL0 = ADCINCH_4; break; // Fallback to thermistor
+    }
+    
+    Event result;
+    Queue_Flush(&adcQueue);
+    ADCCTL0 |= ADCENC | ADCSC;
+    while(!Event_Get(&adcQueue, &result));
+    return result.arg16;
+}
+
+void thermistor_InitADC() {
+    // Configure ONLY the thermistor pin (P1.4)
+    P1SEL0 |= BIT4;
+    P1SEL1 |= BIT4;
+
+    // ADC Configuration (matches your style)
+    ADCCTL0 |= ADCSHT_2 | ADCON;
+    ADCCTL1 |= ADCSHP;
+    ADCCTL2 = (ADCCTL2 & ~ADCRES) | ADCRES_2;
+    ADCIE |= ADCIE0;
+}
+
+int16_t thermistor_ReadTemp() {
+    uint16_t adcValue = readADC(THERMISTOR_ADC_CH);
+
+    return thermistor_AdcToTemp(adcValue); // Return as 0.01°C units (e.g., 2500 = 25.00°C)
+}
+
+int16_t thermistor_AdcToTemp(uint16_t adcValue) {
+    if (adcValue == 0) adcValue = 1;       // Avoid log2(0) at either rail
+    if (adcValue > 4094) adcValue = 4094;
+
+    // log2(R/R0) in Q16.16, then scale by ln(2)/B into 1/T (Q32)
+    int32_t log2Ratio = FX_Log2Q16(4095 - adcValue) - FX_Log2Q16(adcValue);
+    int32_t invT = INV_T0_Q32 + FX_MulHiS32(log2Ratio << 8, LN2_OVER_BETA_Q40);
+
+    // Single 32-bit divide replaces the float log and three float divides
+    uint32_t tempK = (100UL << 24) / (uint32_t)(invT >> 8);
+
+    return FX_SatS16((int32_t)tempK - KELVIN_OFFSET);
 }
\ No newline at end of file
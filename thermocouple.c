@@ -1,51 +1,207 @@
-#include "thermocouple.h"
-#include <msp430.h>
-
-// Debug variables
-volatile uint16_t rawADCValue = 0;
-volatile uint16_t filteredValue = 0;
-
-static uint16_t ReadADC(void) {
-    ADCMCTL0 = ADCINCH_3;             // Select channel A3
-    ADCCTL0 |= ADCENC | ADCSC;        // Start conversion
-    while (!(ADCCTL1 & ADCIFG));      // Wait for completion
-    ADCCTL1 &= ~ADCIFG;               // Clear flag
-    rawADCValue = ADCMEM0;            // Store for debugging
-    return rawADCValue;
-}
-
-static uint16_t ApplyFilter(void) {
-    static uint16_t samples[SAMPLE_BUFFER_SIZE] = {0};
-    static uint8_t sampleIndex = 0;
-    uint32_t sum = 0;
-    uint8_t i;
-    
-    // Update circular buffer (using bitmask instead of modulo)
-    samples[sampleIndex] = ReadADC();
-    sampleIndex = (sampleIndex + 1) & (SAMPLE_BUFFER_SIZE - 1);
-    
-    // Calculate moving average (counting down for ULP)
-    for(i = SAMPLE_BUFFER_SIZE; i > 0; i--) {
-        sum += samples[i-1];
-    }
-    
-    filteredValue = (uint16_t)(sum >> 2); // Divide by 4 (for SAMPLE_BUFFER_SIZE=5)
-    return filteredValue;
-}
-
-void Thermocouple_Init(void) {
-    // Configure ADC pin
-    P1SEL0 |= BIT3;
-    P1SEL1 |= BIT3;
-    
-    // Configure ADC
-    ADCCTL0 = ADCSHT_8 | ADCON;
-    ADCCTL1 = ADCSHP;
-    ADCCTL2 = ADCRES_2;
-    ADCMCTL0 = ADCINCH_3;
-}
-
-uint8_t Thermocouple_FlameDetected(void) {
-    uint16_t adcValue = ApplyFilter();
-    return (adcValue > FLAME_THRESHOLD_ADC) ? 1 : 0;
+#include "thermocouple.h"
+#include "ramfunc.h"
+#include "SENSORS.h"
+#include <msp430.h>
+
+// Debug variables
+volatile uint16_t rawADCValue = 0;
+volatile uint16_t filteredValue = 0;
+volatile int16_t flameSlope = 0;
+
+#if FLAME_THRESHOLD_ADC * 5 > 4095
+#error "TC_GAIN_DEFAULT (gain 5) would push FLAME_THRESHOLD_ADC past full scale"
+#endif
+
+// Amplifier gain and SAC0PGA GAIN code (non-inverting mode) per TcGain
+static const uint8_t gainValue[] = { 1, 1, 2, 3, 5, 9, 17, 25, 33 };
+static const uint8_t gainCode[]  = { 0, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+// 2^29 / gain, rounded up: tc_AdcToTemp() takes the Q4 reading through
+// one 32x32 high multiply instead of a 32-bit divide (fixmath.h FX_Q24
+// gives too few bits for the 28-bit Q4 product)
+#define TC_RECIP(g)  ((int32_t)(((1UL << 29) + (g) - 1) / (g)))
+const int32_t tcGainRecip[] = {
+    TC_RECIP(1), TC_RECIP(1), TC_RECIP(2), TC_RECIP(3), TC_RECIP(5),
+    TC_RECIP(9), TC_RECIP(17), TC_RECIP(25), TC_RECIP(33)
+};
+
+// Detector levels for the active gain
+static uint8_t adcChannel = THERMOCOUPLE_ADC_CH;
+static uint8_t gain = 1;
+static uint8_t gainSetting = TC_GAIN_DIRECT;
+static uint16_t flameOnAdc = FLAME_THRESHOLD_ADC;
+static uint16_t flameOffAdc = FLAME_OFF_ADC;
+static int16_t riseSlope = FLAME_RISE_SLOPE;
+static int16_t fallSlope = FLAME_FALL_SLOPE;
+static uint8_t flameConfirmed = 0;      // Flame, and above the absolute threshold
+
+// Through readADC(): with ADCIE0 set the ADC ISR consumes ADCIFG, so
+// polling the flag here would never see it
+RAMFUNC static uint16_t ReadADC(void) {
+    rawADCValue = readADC(adcChannel);  // Store for debugging
+    return rawADCValue;
+}
+
+RAMFUNC static uint16_t ApplyFilter(uint16_t sample) {
+    static uint16_t samples[SAMPLE_BUFFER_SIZE] = {0};
+    static uint8_t sampleIndex = 0;
+    uint32_t sum = 0;
+    uint8_t i;
+    
+    // Update circular buffer (using bitmask instead of modulo)
+    samples[sampleIndex] = sample;
+    sampleIndex = (sampleIndex + 1) & (SAMPLE_BUFFER_SIZE - 1);
+    
+    // Calculate moving average (counting down for ULP)
+    for(i = SAMPLE_BUFFER_SIZE; i > 0; i--) {
+        sum += samples[i-1];
+    }
+    
+    filteredValue = (uint16_t)(sum / SAMPLE_BUFFER_SIZE);  // Power of 2, compiles to a shift
+    return filteredValue;
+}
+
+// Slope of the filtered signal over the last SLOPE_WINDOW samples
+RAMFUNC static int16_t UpdateSlope(uint16_t filtered) {
+    static uint16_t history[SLOPE_WINDOW] = {0};
+    static uint8_t historyIndex = 0;
+    static uint8_t historyFill = 0;
+    
+    uint16_t oldest = history[historyIndex];
+    history[historyIndex] = filtered;
+    historyIndex = (historyIndex + 1) & (SLOPE_WINDOW - 1);
+    
+    // No slope until the window holds real samples
+    if (historyFill < SLOPE_WINDOW) {
+        historyFill++;
+        return 0;
+    }
+    
+    flameSlope = (int16_t)(filtered - oldest);
+    return flameSlope;
+}
+
+// Single unfiltered conversion; leaves the detector state untouched
+uint16_t Thermocouple_ReadRaw(void) {
+    return ReadADC();
+}
+
+// Single unfiltered conversion against the absolute flame level
+uint8_t Thermocouple_FlameLevel(void) {
+    return ReadADC() > flameOnAdc;
+}
+
+void Thermocouple_Init(void) {
+    // Configure ADC pin
+    P1SEL0 |= BIT3;
+    P1SEL1 |= BIT3;
+    
+    // Configure ADC
+    ADCCTL0 = ADCSHT_8 | ADCON;
+    ADCCTL1 = ADCSHP;
+    ADCCTL2 = ADCRES_2;
+    ADCMCTL0 = ADCINCH_3;
+}
+
+static uint16_t ScaleLevel(uint16_t level) {
+    uint32_t scaled = (uint32_t)level * gain;
+    return (scaled > 4095) ? 4095 : (uint16_t)scaled;
+}
+
+// The SAC gain replaces ADC range the bare microvolt signal left unused,
+// so each conversion resolves gain times finer at the same sample time
+void Thermocouple_SetGain(TcGain setting) {
+    if (setting > TC_GAIN_33) setting = TC_GAIN_DEFAULT;
+    
+    if (setting == TC_GAIN_DIRECT) {
+        SAC0OA = 0;                       // Amplifier off
+        adcChannel = THERMOCOUPLE_ADC_CH;
+    } else {
+        // P1.3 = OA0+, P1.1 = OA0O, both analog
+        P1SEL0 |= BIT1 | BIT3;
+        P1SEL1 |= BIT1 | BIT3;
+        
+        // Non-inverting PGA: + from the pin, - from the gain ladder
+        SAC0OA = NMUXEN | PMUXEN | PSEL_0 | NSEL_1;
+        SAC0PGA = MSEL_2 | ((uint16_t)gainCode[setting] << 4);   // GAIN2..0
+        SAC0OA |= SACEN | OAEN;
+        adcChannel = THERMOCOUPLE_PGA_CH;
+    }
+    
+    gainSetting = setting;
+    gain = gainValue[setting];
+    flameOnAdc = ScaleLevel(FLAME_THRESHOLD_ADC);
+    flameOffAdc = ScaleLevel(FLAME_OFF_ADC);
+    riseSlope = FLAME_RISE_SLOPE * gain;
+    fallSlope = FLAME_FALL_SLOPE * gain;
+}
+
+uint8_t Thermocouple_Gain(void) {
+    return gain;
+}
+
+uint8_t Thermocouple_GainSetting(void) {
+    return gainSetting;
+}
+
+uint8_t Thermocouple_Channel(void) {
+    return adcChannel;
+}
+
+// Software-triggered conversion through the detector
+RAMFUNC uint8_t Thermocouple_FlameDetected(void) {
+    return Thermocouple_DetectSample(ReadADC());
+}
+
+// One detector step; samples must arrive every FLAME_SAMPLE_MS
+RAMFUNC uint8_t Thermocouple_DetectSample(uint16_t sample) {
+    static uint8_t flame = 0;
+    static uint8_t riseCount = 0;
+    static uint8_t fallCount = 0;
+    static uint16_t confirmCount = 0;   // Samples since slope-only declaration
+    
+    rawADCValue = sample;
+    uint16_t adcValue = ApplyFilter(sample);
+    int16_t slope = UpdateSlope(adcValue);
+    
+    // Count sustained rise/fall, any other sample breaks the run
+    riseCount = (slope >= riseSlope && riseCount < 255) ? riseCount + 1 : 0;
+    fallCount = (slope <= -fallSlope && fallCount < 255) ? fallCount + 1 : 0;
+    
+    if (!flame) {
+        if (adcValue > flameOnAdc) {
+            flame = 1;                  // Absolute backstop
+            confirmCount = 0;
+        } else if (riseCount >= FLAME_RISE_COUNT) {
+            flame = 1;                  // Sustained rate of rise
+            confirmCount = 1;
+        }
+    } else {
+        if (fallCount >= FLAME_FALL_COUNT) {
+            flame = 0;                  // Sustained cooling
+        } else if (confirmCount) {
+            // A slope-only flame must reach the absolute threshold in time
+            if (adcValue > flameOnAdc) {
+                confirmCount = 0;
+            } else if (++confirmCount > FLAME_CONFIRM_SAMPLES) {
+                flame = 0;
+            }
+        } else if (adcValue < flameOffAdc) {
+            flame = 0;                  // Absolute backstop with hysteresis
+        }
+        
+        if (!flame) {
+            riseCount = 0;
+            confirmCount = 0;
+        }
+    }
+    
+    flameConfirmed = flame && !confirmCount;
+    return flame;
+}
+
+// A slope-only flame is reported at once so ignition can stop sparking,
+// but gas beyond the pilot waits for this
+uint8_t Thermocouple_FlameConfirmed(void) {
+    return flameConfirmed;
 }
\ No newline at end of file
@@ -1,15 +1,64 @@
-#ifndef THERMOCOUPLE_H_
-#define THERMOCOUPLE_H_
-
-#include <stdint.h>
-
-// Configuration
-#define THERMOCOUPLE_ADC_CH       3   // P1.3 (A3)
-#define FLAME_THRESHOLD_ADC     500   // Empirical ADC threshold
-#define SAMPLE_BUFFER_SIZE       5    // Moving average filter size
-
-// Function Prototypes
-void Thermocouple_Init(void);
-uint8_t Thermocouple_FlameDetected(void);
-
+#ifndef THERMOCOUPLE_H_
+#define THERMOCOUPLE_H_
+
+#include <stdint.h>
+
+// Configuration
+#define THERMOCOUPLE_ADC_CH       3   // P1.3 (A3), direct
+#define THERMOCOUPLE_PGA_CH       1   // P1.1 (A1), SAC0 output OA0O
+#define FLAME_THRESHOLD_ADC     500   // Empirical ADC threshold at gain 1 (absolute backstop)
+#define FLAME_OFF_ADC           450   // Backstop release level at gain 1 (hysteresis)
+#define SAMPLE_BUFFER_SIZE       2    // Moving average filter size (power of 2), 40ms
+
+// Rate-of-rise detection, tuned for one sample per 20ms (the valve PWM
+// period, which triggers the conversions; see acquire.h)
+#define FLAME_SAMPLE_MS         20
+#define SLOPE_WINDOW             4    // Slope = filtered[n] - filtered[n-4] (power of 2), 80ms
+#define FLAME_RISE_SLOPE        12    // ADC counts per window to count as rising
+#define FLAME_FALL_SLOPE        12    // ADC counts per window to count as falling
+#define FLAME_RISE_COUNT         3    // Consecutive rising samples to declare flame
+#define FLAME_FALL_COUNT         3    // Consecutive falling samples to declare loss
+#define FLAME_CONFIRM_SAMPLES  150    // Slope-declared flame must reach threshold within this (3s)
+
+// Front end. TC_GAIN_DIRECT feeds P1.3 straight to the ADC; the others
+// route it through SAC0 as a non-inverting PGA (OA0+ = P1.3). ADC
+// levels and slopes above are for gain 1 and are scaled by the gain.
+typedef enum {
+    TC_GAIN_DIRECT,
+    TC_GAIN_1,
+    TC_GAIN_2,
+    TC_GAIN_3,
+    TC_GAIN_5,
+    TC_GAIN_9,
+    TC_GAIN_17,
+    TC_GAIN_25,
+    TC_GAIN_33
+} TcGain;
+
+#define TC_GAIN_DEFAULT   TC_GAIN_5   // Highest gain that keeps FLAME_THRESHOLD_ADC in range
+
+// Temperature conversion at gain 1: 0.01°C per ADC code = 3.3 / 4095 /
+// 40µV * 100, held as Q4 so the 12-bit reading needs one 16x16 multiply
+#define TC_CENTI_PER_CODE_Q4  32234   // 2014.65 * 16
+#define TC_OFFSET_CENTI       2500    // 1mV offset / 40µV/°C * 100
+
+// Input-referred scale per TcGain for tc_AdcToTemp(), 2^29 / gain
+extern const int32_t tcGainRecip[];
+
+// Last conversion and filtered signal (debug/telemetry)
+extern volatile uint16_t rawADCValue;
+extern volatile uint16_t filteredValue;
+
+// Function Prototypes
+void Thermocouple_Init(void);
+uint8_t Thermocouple_FlameDetected(void);
+uint8_t Thermocouple_DetectSample(uint16_t sample);   // Detector step on a given conversion
+uint8_t Thermocouple_FlameConfirmed(void);            // Flame that reached the absolute threshold
+uint16_t Thermocouple_ReadRaw(void);
+uint8_t Thermocouple_FlameLevel(void);
+void Thermocouple_SetGain(TcGain gain);
+uint8_t Thermocouple_Gain(void);          // Amplifier gain, 1 when direct
+uint8_t Thermocouple_GainSetting(void);   // Active TcGain
+uint8_t Thermocouple_Channel(void);       // ADC input for the active front end
+
 #endif 
\ No newline at end of file
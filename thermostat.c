@@ -0,0 +1,104 @@
+#include "thermostat.h"
+#include "events.h"
+#include "ramfunc.h"
+#include <msp430.h>
+
+// Interval classes split at 1.5 half-bits, so bit rate errors up to
+// ±25% still classify correctly
+#define SHORT_MIN   (THERMOSTAT_HALF_BIT / 2)
+#define SHORT_MAX   (THERMOSTAT_HALF_BIT * 3 / 2 - 1)
+#define LONG_MIN    (THERMOSTAT_HALF_BIT * 3 / 2)
+#define LONG_MAX    (THERMOSTAT_HALF_BIT * 5 / 2)
+
+typedef enum {
+    DECODE_IDLE,               // Waiting for the start bit's falling edge
+    DECODE_START,              // Expecting the start bit's mid-bit edge
+    DECODE_BITS                // Data and stop bits
+} DecodeState;
+
+volatile uint16_t thermostatErrors = 0;
+
+static uint8_t state = DECODE_IDLE;
+static uint16_t lastEdge = 0;
+static uint8_t boundary = 0;               // Saw a bit-boundary edge
+static uint8_t bitCount = 0;
+static uint32_t shift = 0;
+
+// Timer_A0 runs continuously on ACLK (timebase.c); CCR1 captures its
+// count when the port ISR flips the capture input between GND and VCC
+void Thermostat_Init(void) {
+    TA0CCTL1 = CM_3 | CCIS_2 | CAP;
+}
+
+static RAMFUNC uint16_t CaptureNow(void) {
+    TA0CCTL1 ^= CCIS0;                     // GND <-> VCC, captures TA0R
+    TA0CCTL1 &= ~CCIFG;
+    return TA0CCR1;
+}
+
+static RAMFUNC void Reset(uint8_t level) {
+    if (state != DECODE_IDLE) thermostatErrors++;
+    // A falling edge may itself be the start of the next frame
+    state = level ? DECODE_IDLE : DECODE_START;
+}
+
+static RAMFUNC void FrameDone(void) {
+    uint8_t flags = (uint8_t)(shift >> 24);
+    uint8_t setpoint = (uint8_t)(shift >> 16);
+    uint8_t modulation = (uint8_t)(shift >> 8);
+    uint8_t check = (uint8_t)shift;
+    
+    if ((uint8_t)~(flags + setpoint + modulation) != check) {
+        thermostatErrors++;
+        return;
+    }
+    Event_Post(&eventQueue, EVENT_THERMOSTAT_FRAME, flags,
+               setpoint | ((uint16_t)modulation << 8));
+}
+
+// Manchester decoding from edge spacing: after a mid-bit edge, a long
+// gap means the next edge is mid-bit again (bit value flips); two short
+// gaps mean a boundary edge then a mid-bit edge (bit value repeats).
+// The bit is the direction of the mid-bit edge.
+RAMFUNC void Thermostat_Edge(uint8_t level) {
+    uint16_t now = CaptureNow();
+    uint16_t gap = now - lastEdge;
+    lastEdge = now;
+    
+    switch (state) {
+        case DECODE_IDLE:
+            if (!level) state = DECODE_START;
+            break;
+            
+        case DECODE_START:
+            if (level && gap >= SHORT_MIN && gap <= SHORT_MAX) {
+                state = DECODE_BITS;
+                boundary = 0;
+                bitCount = 0;
+                shift = 0;
+            } else {
+                Reset(level);
+            }
+            break;
+            
+        case DECODE_BITS:
+            if (gap >= SHORT_MIN && gap <= SHORT_MAX) {
+                boundary ^= 1;
+                if (boundary) break;       // Boundary edge, mid-bit follows
+            } else if (gap < LONG_MIN || gap > LONG_MAX || boundary) {
+                Reset(level);
+                break;
+            }
+            
+            // Mid-bit edge
+            if (bitCount < THERMOSTAT_FRAME_BITS) {
+                shift = (shift << 1) | level;
+                bitCount++;
+            } else {
+                if (level) FrameDone();    // Stop bit must be 1
+                else thermostatErrors++;
+                state = DECODE_IDLE;
+            }
+            break;
+    }
+}
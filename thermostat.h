@@ -0,0 +1,38 @@
+#ifndef THERMOSTAT_H_
+#define THERMOSTAT_H_
+
+#include <stdint.h>
+
+// Heat request input on P4.1: a plain active-low level, or a digital
+// thermostat link carrying Manchester frames on the same pin.
+typedef enum {
+    THERMOSTAT_LEVEL,
+    THERMOSTAT_DIGITAL
+} ThermostatMode;
+
+#define THERMOSTAT_MODE_DEFAULT  THERMOSTAT_LEVEL
+
+// Link timing: 1000 bit/s, IEEE 802.3 Manchester (rising mid-bit edge
+// = 1), idle high. Edges are timestamped on the ACLK time base.
+#define THERMOSTAT_HALF_BIT      16     // 500µs in 32768Hz ticks
+#define THERMOSTAT_TIMEOUT_MS    5000   // Demand drops without a valid frame
+
+// Frame: start bit (1), flags, setpoint, modulation, check, stop bit (1),
+// data bytes MSB first. check = ~(flags + setpoint + modulation).
+#define THERMOSTAT_FRAME_BITS    32
+#define THERMOSTAT_FLAG_HEAT     0x01
+
+// Latest decoded frame
+typedef struct {
+    uint8_t heatDemand;
+    uint8_t setpoint;          // 0.5°C units
+    uint8_t modulation;        // Percent, 0 = no request
+} ThermostatFrame;
+
+extern volatile uint16_t thermostatErrors;
+
+// Function Prototypes
+void Thermostat_Init(void);
+void Thermostat_Edge(uint8_t level);     // From the P4 ISR, level after the edge
+
+#endif
@@ -0,0 +1,166 @@
+#include "timebase.h"
+#include "metrics.h"
+#include "ramfunc.h"
+#include <msp430.h>
+
+#define TIME_MIN_LEAD  2                 // Closer deadlines fire immediately
+
+static volatile uint16_t timeHigh = 0;   // Upper 16 bits, counted by TAIFG
+static uint32_t deadlines[TIME_DEADLINE_COUNT];
+static volatile uint8_t armed = 0;
+static volatile uint8_t expired = 0;
+static volatile uint8_t woken = 0;
+
+static uint32_t lastTaken = 0;           // Time_TakeElapsedMs() state
+static uint32_t msResidual = 0;          // Fractional ms, 1/32768ms units
+
+// Interrupts must be off
+static RAMFUNC uint32_t ReadNow(void) {
+    uint16_t hi = timeHigh;
+    uint16_t lo;
+    
+    // ACLK is asynchronous to MCLK, so read until two reads agree
+    do {
+        lo = TA0R;
+    } while (lo != TA0R);
+    
+    // Overflowed but the ISR has not run yet
+    if ((TA0CTL & TAIFG) && !(lo & 0x8000)) hi++;
+    
+    return ((uint32_t)hi << 16) | lo;
+}
+
+// Expire due deadlines and arm CCR0 for the nearest remaining one.
+// Deadlines further out than one timer period are picked up by a
+// later overflow. Interrupts must be off. Returns 1 if any expired.
+static RAMFUNC uint8_t Schedule(void) {
+    uint32_t now = ReadNow();
+    uint32_t nearest = 0xFFFFFFFFUL;
+    uint8_t fired = 0;
+    uint8_t id;
+    
+    for (id = 0; id < TIME_DEADLINE_COUNT; id++) {
+        if (!(armed & (1 << id))) continue;
+        
+        int32_t remaining = (int32_t)(deadlines[id] - now);
+        if (remaining <= TIME_MIN_LEAD) {
+            armed &= ~(1 << id);
+            expired |= (1 << id);
+            fired = 1;
+        } else if ((uint32_t)remaining < nearest) {
+            nearest = (uint32_t)remaining;
+        }
+    }
+    
+    if (nearest <= 0xFFFF) {
+        TA0CCR0 = (uint16_t)(now + nearest);
+        TA0CCTL0 = CCIE;                 // Also clears a stale CCIFG
+    } else {
+        TA0CCTL0 = 0;
+    }
+    return fired;
+}
+
+void Time_Init(void) {
+    TA0CCTL0 = 0;
+    TA0CTL = TASSEL__ACLK | MC__CONTINUOUS | TACLR | TAIE;
+}
+
+uint32_t Time_Now(void) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    uint32_t now = ReadNow();
+    __set_interrupt_state(gie);
+    return now;
+}
+
+// The main loop never blocks long enough for delta * 1000 to overflow
+// (131s)
+uint16_t Time_TakeElapsedMs(void) {
+    uint32_t now = Time_Now();
+    
+    msResidual += (now - lastTaken) * 1000;
+    lastTaken = now;
+    
+    uint16_t ms = (uint16_t)(msResidual >> 15);
+    msResidual &= 0x7FFF;
+    return ms;
+}
+
+void Time_Arm(TimeDeadline id, uint32_t when) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    deadlines[id] = when;
+    expired &= ~(1 << id);
+    armed |= (1 << id);
+    Schedule();
+    __set_interrupt_state(gie);
+}
+
+void Time_Disarm(TimeDeadline id) {
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    armed &= ~(1 << id);
+    expired &= ~(1 << id);
+    Schedule();
+    __set_interrupt_state(gie);
+}
+
+uint8_t Time_Expired(TimeDeadline id) {
+    uint8_t mask = 1 << id;
+    
+    if (!(expired & mask)) return 0;
+    
+    uint16_t gie = __get_interrupt_state();
+    __disable_interrupt();
+    expired &= ~mask;
+    __set_interrupt_state(gie);
+    return 1;
+}
+
+uint8_t Time_Sleep(TimeDeadline id) {
+    uint8_t reached;
+    
+    // Check and sleep with interrupts off so a wakeup between the two
+    // is not lost; LPM0 keeps SMCLK for the valve PWM
+    __disable_interrupt();
+    while (!(expired & (1 << id)) && !woken) {
+        __bis_SR_register(LPM0_bits | GIE);
+        __disable_interrupt();
+    }
+    reached = (expired & (1 << id)) ? 1 : 0;
+    expired &= ~(1 << id);
+    woken = 0;
+    __enable_interrupt();
+    
+    // Woken for new work: the deadline is no longer wanted
+    if (!reached) Time_Disarm(id);
+    return reached;
+}
+
+// The ISR must also clear LPM0 on exit
+RAMFUNC void Time_Wake(void) {
+    woken = 1;
+}
+
+// CCR0: nearest deadline reached
+#pragma vector=TIMER0_A0_VECTOR
+RAMFUNC __interrupt void Timer_A0_ISR(void) {
+    Metrics_Count(METRIC_TIMER_WAKEUPS);
+    Schedule();
+    __bic_SR_register_on_exit(LPM0_bits);
+}
+
+// Overflow: extend the count and look at far deadlines again
+#pragma vector=TIMER0_A1_VECTOR
+RAMFUNC __interrupt void Timer_A1_ISR(void) {
+    switch (__even_in_range(TA0IV, TA0IV_TAIFG)) {
+        case TA0IV_TAIFG:
+            timeHigh++;
+            Metrics_Count(METRIC_TIMER_WAKEUPS);
+            if (Schedule()) __bic_SR_register_on_exit(LPM0_bits);
+            break;
+        default:
+            break;
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include <stdint.h>
+
+// Tickless time base: Timer_A0 free-running on ACLK (32768Hz REFO),
+// extended to 32 bits in software by its overflow interrupt (every 2s).
+// CCR0 is only armed for the earliest pending deadline.
+#define TIME_TICKS_PER_SEC   32768UL
+#define TIME_MS_TO_TICKS(ms) ((((uint32_t)(ms) * TIME_TICKS_PER_SEC) + 999) / 1000)
+
+// Deadline slots, one per user
+typedef enum {
+    TIME_DEADLINE_DELAY,       // delay_ms() wakeup
+    TIME_DEADLINE_COUNT
+} TimeDeadline;
+
+// Function Prototypes
+void Time_Init(void);
+uint32_t Time_Now(void);                     // Ticks since reset, no interrupt needed
+uint16_t Time_TakeElapsedMs(void);           // Whole ms since the previous call
+void Time_Arm(TimeDeadline id, uint32_t when);
+void Time_Disarm(TimeDeadline id);
+uint8_t Time_Expired(TimeDeadline id);       // Clears the flag when set
+uint8_t Time_Sleep(TimeDeadline id);         // LPM0 until the deadline, 0 if woken early
+void Time_Wake(void);                        // From an ISR: end Time_Sleep() early
+
+#endif
@@ -0,0 +1,179 @@
+#include "SENSORS.h"
+#include "thermistor.h"
+#include "thermocouple.h"
+#include "potentiometer.h"
+#include "sim.h"
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+// Host accuracy gate and benchmark for the sensor conversions:
+//
+//     conversion_bench
+//
+// Every conversion runs over all 4096 ADC codes. The result is compared
+// with a double-precision reference of the same formula, with the input
+// clamped as the firmware clamps it and the output clamped to the
+// result type. The bench reports max and RMS error, checks monotonicity
+// and times conversions per second (host numbers, for comparing changes
+// only).
+//
+// The read routines (therm_Read(), thermistor_ReadTemp(),
+// readThermocouple(), readPot(), Pot_Read()) go through the real ADC
+// path on the plant simulator's register model with the code under test
+// as the conversion result. They must equal their pure conversion.
+//
+// Exits 1 when a conversion is over its error limit, not monotonic, or
+// a read routine disagrees with its conversion.
+
+#define CODES        4096
+#define TIMING_REPS  200
+
+// From Potentiometer.c
+#define POT_MIN_ADC  100
+#define POT_MAX_ADC  4095
+
+static uint16_t adcCode;                 // What every conversion returns
+static unsigned failures;
+
+// Simulator hooks: no plant, the ADC returns adcCode
+uint16_t Plant_AdcCode(uint8_t channel) { (void)channel; return adcCode; }
+uint64_t Plant_Next(void) { return ~0ULL; }
+void Plant_Run(void) {}
+void Port_2_ISR(void) {}
+void Port_4_ISR(void) {}
+void MainValve_ISR(void) {}
+
+typedef struct {
+    const char *name;
+    const char *unit;
+    double maxLimit;                     // Max |error| allowed, output units
+    double rmsLimit;
+    long (*convert)(uint16_t code);
+    double (*reference)(uint16_t code);
+    long (*read)(void);                  // Full read path, 0 if none
+} Conversion;
+
+static double Clamp(double x, double lo, double hi) {
+    return x < lo ? lo : (x > hi ? hi : x);
+}
+
+// Thermistor: NTC over SERIES_RESISTOR, B equation, 0.01 C
+static double ThermistorRef(uint16_t code) {
+    double c = Clamp(code, 1, 4094);
+    double invT = 1.0 / 298.15 + log((4095.0 - c) / c) / THERMISTOR_BETA;
+    return Clamp((1.0 / invT - 273.15) * 100.0, -32768, 32767);
+}
+static long ThermistorConv(uint16_t code) { return thermistor_AdcToTemp(code); }
+static long ThermRead(void) { return therm_Read(); }
+static long ThermistorRead(void) { return thermistor_ReadTemp(); }
+
+// Thermocouple: 3.3 V / 4095 per code, 40 uV/C, input-referred, 0.01 C
+static uint8_t tcGain = 1, tcSetting = TC_GAIN_DIRECT;
+static double ThermocoupleRef(uint16_t code) {
+    double centi = code * (3.3 / 4095.0 / 40e-6 * 100.0) / tcGain - TC_OFFSET_CENTI;
+    return Clamp(centi, 0, 65535);
+}
+static long ThermocoupleConv(uint16_t code) { return tc_AdcToTemp(code, tcSetting); }
+static long ThermocoupleRead(void) { return readThermocouple(); }
+
+// Potentiometers: linear to 0-100 %, truncated
+static double PotRef(uint16_t code) { return code * 100.0 / 4095.0; }
+static long PotConv(uint16_t code) { return pot_AdcToPercent(code); }
+static long PotRead(void) { return readPot(); }
+
+static double PotModRef(uint16_t code) {
+    return (Clamp(code, POT_MIN_ADC, POT_MAX_ADC) - POT_MIN_ADC) * 100.0 / (POT_MAX_ADC - POT_MIN_ADC);
+}
+static long PotModConv(uint16_t code) { return Pot_AdcToPercent(code); }
+static long PotModRead(void) { return Pot_Read(); }
+
+static double Seconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void Run(const Conversion *c) {
+    double maxErr = 0, sumSq = 0, start, rate;
+    long out, prev = 0, readMismatch = 0;
+    volatile long sink = 0;              // Keeps the timed calls
+    int direction = 0, monotonic = 1;
+    uint16_t code, worst = 0;
+    unsigned rep;
+    uint8_t pass;
+
+    for (code = 0; code < CODES; code++) {
+        double err;
+
+        out = c->convert(code);
+        err = fabs(out - c->reference(code));
+        sumSq += err * err;
+        if (err > maxErr) {
+            maxErr = err;
+            worst = code;
+        }
+
+        // Non-strict, in the direction the reference runs
+        if (code > 0 && out != prev) {
+            int step = (out > prev) ? 1 : -1;
+            if (!direction) direction = (c->reference(CODES - 1) >= c->reference(0)) ? 1 : -1;
+            if (step != direction) monotonic = 0;
+        }
+        prev = out;
+
+        if (c->read) {
+            adcCode = code;
+            if (c->read() != out) readMismatch++;
+        }
+    }
+
+    start = Seconds();
+    for (rep = 0; rep < TIMING_REPS; rep++) {
+        for (code = 0; code < CODES; code++) sink += c->convert(code);
+    }
+    rate = (double)TIMING_REPS * CODES / (Seconds() - start);
+
+    pass = maxErr <= c->maxLimit && sqrt(sumSq / CODES) <= c->rmsLimit && monotonic && !readMismatch;
+    if (!pass) failures++;
+    printf("%-22s max %6.3f (code %4u)  rms %5.3f %-6s %s  %6.1f M/s  %s%s\n",
+           c->name, maxErr, worst, sqrt(sumSq / CODES), c->unit,
+           monotonic ? "monotonic    " : "NOT monotonic", rate / 1e6,
+           pass ? "ok" : "FAIL", readMismatch ? "  read path differs" : "");
+}
+
+int main(void) {
+    static const struct { TcGain setting; uint8_t gain; } gains[] = {
+        { TC_GAIN_DIRECT, 1 }, { TC_GAIN_2, 2 }, { TC_GAIN_3, 3 }, { TC_GAIN_5, 5 },
+        { TC_GAIN_9, 9 }, { TC_GAIN_17, 17 }, { TC_GAIN_25, 25 }, { TC_GAIN_33, 33 },
+    };
+    const Conversion thermistor[] = {
+        { "therm_Read", "0.01C", 2.5, 1.0, ThermistorConv, ThermistorRef, ThermRead },
+        { "thermistor_ReadTemp", "0.01C", 2.5, 1.0, ThermistorConv, ThermistorRef, ThermistorRead },
+    };
+    const Conversion pots[] = {
+        { "readPot", "%", 0.9999, 0.6, PotConv, PotRef, PotRead },
+        { "Pot_Read", "%", 0.9999, 0.6, PotModConv, PotModRef, PotModRead },
+    };
+    Conversion tc = { 0, "0.01C", 2.0, 1.0, ThermocoupleConv, ThermocoupleRef, ThermocoupleRead };
+    char name[32];
+    unsigned i;
+
+    initADC();
+    __bis_SR_register(GIE);
+
+    for (i = 0; i < sizeof(thermistor) / sizeof(thermistor[0]); i++) Run(&thermistor[i]);
+    for (i = 0; i < sizeof(gains) / sizeof(gains[0]); i++) {
+        Thermocouple_SetGain(gains[i].setting);
+        tcGain = gains[i].gain;
+        tcSetting = gains[i].setting;
+        snprintf(name, sizeof(name), "readThermocouple x%u", gains[i].gain);
+        tc.name = name;
+        Run(&tc);
+    }
+    for (i = 0; i < sizeof(pots) / sizeof(pots[0]); i++) Run(&pots[i]);
+
+    printf("conversion bench: %u failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+#include "demand.h"
+#include "metrics.h"
+#include "system_state.h"
+#include <msp430.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Host driver for demand.c, run by tools/demand_sim.py:
+//
+//     demand_replay <hours> <min_burn_ms> <min_off_ms> <merge_ms> <pilot_hold_ms> < edges
+//
+// Reads "<time_ms> <request 0/1>" edges from stdin and feeds the request
+// through the unmodified Demand_Update() every STEP_MS, with the burner
+// sequence timing of main.c around it (no flame failures). Prints the
+// totals as name=value pairs.
+
+#define STEP_MS           100
+#define PREPURGE_MS       3000      // main.c PREPURGE_TIME
+#define TIME_TO_FLAME_MS  2000      // Spark until the pilot proves lit
+#define PROVE_MS          1000      // main.c FLAME_PROVE_TIME
+#define SHUTDOWN_MS       1000      // main.c STATE_SHUTDOWN pilot delay
+
+volatile SystemState currentState = STATE_IDLE;
+volatile uint8_t lockoutReason = LOCKOUT_NONE;
+
+// metrics.c registers; single context, nothing to mask
+volatile uint16_t TB2R;
+void __disable_interrupt(void) {}
+uint16_t __get_interrupt_state(void) { return 0; }
+void __set_interrupt_state(uint16_t state) { (void)state; }
+
+int main(int argc, char **argv) {
+    uint64_t now, end, nextEdge = ~0ULL;
+    uint64_t mainMs = 0, pilotOnlyMs = 0, sequenceMs = 0;
+    uint64_t requestedMs = 0, servedMs = 0, unrequestedMs = 0;
+    unsigned long long edgeMs;
+    unsigned long ignitions = 0, reuses = 0;
+    uint32_t timer = 0;
+    uint8_t request = 0, nextLevel = 0, heat;
+    SystemState next;
+    MetricsData metrics;
+    int level;
+
+    if (argc != 6) {
+        fprintf(stderr, "usage: demand_replay hours min_burn_ms min_off_ms merge_ms pilot_hold_ms < edges\n");
+        return 2;
+    }
+    end = (uint64_t)(atof(argv[1]) * 3600000.0);
+    demandConfig.minBurnMs = strtoul(argv[2], 0, 0);
+    demandConfig.minOffMs = strtoul(argv[3], 0, 0);
+    demandConfig.mergeMs = strtoul(argv[4], 0, 0);
+    demandConfig.pilotHoldMs = (uint16_t)strtoul(argv[5], 0, 0);
+
+    if (scanf("%llu %d", &edgeMs, &level) == 2) {
+        nextEdge = edgeMs;
+        nextLevel = (uint8_t)level;
+    }
+
+    for (now = 0; now < end; now += STEP_MS) {
+        while (nextEdge <= now) {
+            request = nextLevel;
+            nextEdge = ~0ULL;
+            if (scanf("%llu %d", &edgeMs, &level) == 2) {
+                nextEdge = edgeMs;
+                nextLevel = (uint8_t)level;
+            }
+        }
+        heat = Demand_Update(request, currentState, STEP_MS);
+
+        if (request) requestedMs += STEP_MS;
+        switch (currentState) {
+            case STATE_MAIN_VALVE:
+                mainMs += STEP_MS;
+                if (request) servedMs += STEP_MS;
+                else unrequestedMs += STEP_MS;
+                break;
+            case STATE_PILOT_HOLD:
+                pilotOnlyMs += STEP_MS;
+                break;
+            case STATE_IDLE:
+                break;
+            default:
+                sequenceMs += STEP_MS;
+                break;
+        }
+
+        next = currentState;
+        switch (currentState) {
+            case STATE_IDLE:
+                if (heat) next = STATE_PREPURGE;
+                break;
+            case STATE_PREPURGE:
+                if (timer >= PREPURGE_MS) {
+                    next = STATE_PILOT_IGNITION;
+                    ignitions++;
+                }
+                break;
+            case STATE_PILOT_IGNITION:
+                if (timer >= TIME_TO_FLAME_MS) next = STATE_PILOT_PROVE;
+                break;
+            case STATE_PILOT_PROVE:
+                if (timer >= PROVE_MS) next = STATE_MAIN_VALVE;
+                break;
+            case STATE_MAIN_VALVE:
+                if (!heat) next = demandConfig.pilotHoldMs ? STATE_PILOT_HOLD : STATE_SHUTDOWN;
+                break;
+            case STATE_PILOT_HOLD:
+                if (heat) {
+                    next = STATE_MAIN_VALVE;
+                    reuses++;
+                } else if (timer >= demandConfig.pilotHoldMs) {
+                    next = STATE_SHUTDOWN;
+                }
+                break;
+            case STATE_SHUTDOWN:
+                if (timer >= SHUTDOWN_MS) next = STATE_IDLE;
+                break;
+            default:
+                break;
+        }
+        if (next != currentState) {
+            currentState = next;
+            timer = 0;
+        } else {
+            timer += STEP_MS;
+        }
+    }
+
+    Metrics_Snapshot(&metrics);
+    printf("ignitions=%lu reuses=%lu merged=%lu main_ms=%llu pilot_only_ms=%llu sequence_ms=%llu "
+           "requested_ms=%llu served_ms=%llu unrequested_ms=%llu\n",
+           ignitions, reuses, (unsigned long)metrics.counters[METRIC_DEMAND_MERGED],
+           (unsigned long long)mainMs, (unsigned long long)pilotOnlyMs,
+           (unsigned long long)sequenceMs, (unsigned long long)requestedMs,
+           (unsigned long long)servedMs, (unsigned long long)unrequestedMs);
+    return 0;
+}
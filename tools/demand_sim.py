@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Replay a heat request trace through the demand scheduler (demand.c).
+
+Builds demand.c unchanged with a host driver (tools/demand_replay.c)
+that wraps it in the burner sequence timing of main.c, runs the same
+request trace through it twice, with demand shaping off and on, and
+reports ignitions per day and runtime efficiency for each.
+
+The trace is either synthetic (a thermostat cycling with chatter: short
+gaps inside calls and brief spurious calls) or a CSV of
+"<time_s>,<request 0/1>" edges.
+
+    demand_sim.py [--hours 24] [--seed 1] [--trace edges.csv]
+                  [--min-burn 120] [--min-off 180] [--merge 30] [--pilot-hold 0]
+                  [--build-dir DIR] [--cc CC]
+"""
+import argparse
+import os
+import random
+import subprocess
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SHIM_DIR = os.path.join(ROOT, "tools", "plant_sim")
+
+# The driver and the unmodified firmware modules it links
+SOURCES = ["tools/demand_replay.c", "demand.c", "metrics.c"]
+HEADERS = ["demand.h", "metrics.h", "system_state.h", "ramfunc.h"]
+
+
+def synthetic_trace(hours, seed):
+    """Edges for a thermostat calling ~8 min on / ~15 min off, with chatter."""
+    rnd = random.Random(seed)
+    end = hours * 3600.0
+    edges = []
+    t = 0.0
+    while t < end:
+        t += rnd.expovariate(1 / 900.0)                 # Off period
+        if rnd.random() < 0.3:                          # Spurious blip
+            edges += [(t, 1), (t + rnd.uniform(5, 40), 0)]
+            t += 60
+        on = rnd.expovariate(1 / 480.0)
+        start = t
+        edges.append((t, 1))
+        while t < start + on:                           # Gaps inside the call
+            t += rnd.expovariate(1 / 180.0)
+            if t < start + on and rnd.random() < 0.5:
+                edges += [(t, 0), (t + rnd.uniform(2, 25), 1)]
+                t += 25
+        t = start + on
+        edges.append((t, 0))
+    return [(s, v) for s, v in edges if s < end]
+
+
+def load_trace(path):
+    edges = []
+    with open(path) as f:
+        for line in f:
+            if line.strip() and not line.startswith("#"):
+                s, v = line.split(",")[:2]
+                edges.append((float(s), int(v)))
+    return edges
+
+
+def build(build_dir, cc):
+    binary = os.path.join(build_dir, "demand_replay")
+    sources = [os.path.join(ROOT, s) for s in SOURCES]
+    headers = [os.path.join(ROOT, h) for h in HEADERS]
+    if os.path.exists(binary):
+        built = os.path.getmtime(binary)
+        if all(os.path.getmtime(f) < built for f in sources + headers):
+            return binary
+
+    os.makedirs(build_dir, exist_ok=True)
+    # The shim directory goes first so <msp430.h> is the host one
+    subprocess.run([cc, "-O2", "-std=gnu99", "-Wall", "-Wno-unknown-pragmas", "-Wno-main",
+                    "-I", SHIM_DIR, "-I", ROOT, "-o", binary] + sources, check=True)
+    return binary
+
+
+def simulate(binary, edges, hours, shaping):
+    """Runs the trace through demand.c; returns the driver's totals."""
+    config = shaping if shaping else (0, 0, 0, 0)
+    trace = "".join(f"{int(round(s * 1000))} {v}\n" for s, v in edges)
+    out = subprocess.run([binary, str(hours)] + [str(v) for v in config], input=trace,
+                         check=True, capture_output=True, text=True).stdout
+    return {k: int(v) for k, v in (field.split("=", 1) for field in out.split())}
+
+
+def report(name, s, hours):
+    lit = s["main_ms"] + s["pilot_only_ms"] + s["sequence_ms"]
+    print(f"{name}:")
+    print(f"  ignitions/day      {s['ignitions'] * 24 / hours:8.1f}")
+    print(f"  pilot relights     {s['reuses'] * 24 / hours:8.1f} /day (no ignition)")
+    print(f"  gaps bridged       {s['merged'] * 24 / hours:8.1f} /day")
+    print(f"  main valve         {s['main_ms'] / 3.6e6:8.2f} h"
+          f"  ({s['unrequested_ms'] / 3.6e6:.2f} h without a request)")
+    print(f"  pilot only         {s['pilot_only_ms'] / 3.6e6:8.2f} h")
+    print(f"  runtime efficiency {100.0 * s['main_ms'] / lit if lit else 0:8.1f} %"
+          "  (main valve / all burner-active time)")
+    print(f"  demand served      {100.0 * s['served_ms'] / s['requested_ms'] if s['requested_ms'] else 0:8.1f} %")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--hours", type=float, default=24)
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--trace")
+    ap.add_argument("--min-burn", type=float, default=120, help="seconds")
+    ap.add_argument("--min-off", type=float, default=180, help="seconds")
+    ap.add_argument("--merge", type=float, default=30, help="seconds")
+    ap.add_argument("--pilot-hold", type=float, default=0, help="seconds, 0 = off")
+    ap.add_argument("--build-dir", default=os.path.join(tempfile.gettempdir(), "demand_sim"))
+    ap.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    args = ap.parse_args()
+
+    edges = load_trace(args.trace) if args.trace else synthetic_trace(args.hours, args.seed)
+    shaping = tuple(int(v * 1000) for v in (args.min_burn, args.min_off, args.merge, args.pilot_hold))
+
+    binary = build(args.build_dir, args.cc)
+    report("unshaped", simulate(binary, edges, args.hours, None), args.hours)
+    report("shaped", simulate(binary, edges, args.hours, shaping), args.hours)
+
+
+if __name__ == "__main__":
+    main()
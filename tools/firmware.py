@@ -0,0 +1,327 @@
+#!/usr/bin/env python3
+"""Build the controller and each demo as its own MSP430 image, then
+report flash/RAM per module and check them against budgets.
+
+The driver library is every .c in the repository root except main.c,
+compiled once into drivers.lib. A target is its main() source(s) linked
+against that archive, so only the modules it references come in; within
+those, function/data subsections and --unused_section_elimination drop
+what is unreferenced, and --opt_level=4 optimizes across the whole
+image at link time.
+
+    firmware.py [target ...]                 build and report (default: all)
+    firmware.py --list                       targets and budgets
+    firmware.py --dry-run [target ...]       print the commands only
+    firmware.py --map X.map <target>         report a map linked elsewhere (CCS)
+
+Targets with HOT_PATHS also get the code size of each listed routine,
+read from the linked .out (ELF) next to the map with GNU nm (--nm).
+These are sizes, not cycle counts; cycles need an MSP430 simulator.
+A routine that --opt_level=4 inlined into all its callers has no symbol
+and is noted as inlined; an ISR cannot be, so a missing one is an error,
+as is a listed routine no source defines.
+
+Needs the TI MSP430 code generation tools (--cgt, default $MSP430_CGT)
+and the device headers and linker files from ccs_base/msp430/include
+(--device-include, default $MSP430_INCLUDE). Exits 1 when a target or
+module is over budget, or a listed ISR is not in its image.
+"""
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+LINKER_CMD = os.path.join(ROOT, "lnk_msp430fr2355.cmd")
+LIBRARY = "drivers.lib"
+STACK_SIZE = 0x100                         # lnk_msp430fr2355.cmd usage notes
+
+# name: (sources with main(), flash budget, RAM budget) in bytes. Flash
+# is FRAM plus vectors and signatures, including persistent data and the
+# load image of whatever is copied at boot; RAM counts the stack and the
+# RAM copy of .TI.ramfunc.
+TARGETS = {
+    "controller":    (["main.c"], 0x7800, 0x0C00),
+    "pilot_valve":   (["demos/Pilot_Valve_Demo.c"], 0x0800, 0x0200),
+    "igniter_led":   (["demos/Igniter_LED.c"], 0x0800, 0x0200),
+    "servo":         (["demos/Servo_Demo.c"], 0x1000, 0x0200),
+    "servo_test":    (["demos/servo_test.c"], 0x0800, 0x0200),
+    "rgb_led":       (["demos/RGB_LED.c"], 0x0800, 0x0200),
+    "thermistor":    (["demos/Thermistor_Main.c"], 0x2000, 0x0400),
+    "call_for_heat": (["demos/CallForHeat.c"], 0x0800, 0x0200),
+    "blink":         (["demos/msp430fr235x_1.c"], 0x0800, 0x0200),
+}
+
+# Per-module ceilings (flash, RAM) for modules sized by design, checked in
+# every target that links them
+MODULE_BUDGETS = {
+    "history": (4096 + 0x600, 0x40),       # HISTORY_LOG_BYTES plus code
+}
+
+# Routines whose size is tracked per target: the ISRs and what runs in
+# them, and the control tick. A routine the optimizer inlined or dropped
+# is reported as missing; take it off the list rather than lose it
+# silently.
+HOT_PATHS = {
+    "controller": [
+        "processState", "therm_Read", "Pot_Read", "MainValve_Set",
+        "Thermocouple_DetectSample", "Acquire_Store",
+        "ADC_ISR", "EUSCI_B1_ISR", "Port_4_ISR", "Port_2_ISR", "Timer3_B1_ISR",
+        "Timer_A0_ISR", "Timer_A1_ISR", "MainValve_ISR",
+    ],
+}
+
+CFLAGS = [
+    "-vmspx", "--data_model=restricted", "--use_hw_mpy=F5",
+    "--define=__MSP430FR2355__", "--silicon_errata=CPU21",
+    "--silicon_errata=CPU22", "--silicon_errata=CPU40",
+    "--opt_level=4", "--opt_for_speed=1",
+    "--gen_func_subsections=on", "--gen_data_subsections=on",
+    "--common=off",                        # Globals land in their module's .bss
+    "--printf_support=minimal", "--diag_wrap=off", "--display_error_number",
+]
+
+RAM_REGIONS = ("RAM", "TINYRAM")
+
+
+def library_sources():
+    return sorted(os.path.basename(p) for p in glob.glob(os.path.join(ROOT, "*.c"))
+                  if os.path.basename(p) != "main.c")
+
+
+def obj_name(build_dir, src):
+    return os.path.join(build_dir, os.path.splitext(os.path.basename(src))[0] + ".obj")
+
+
+def run(cmd, dry_run):
+    print(" ".join(cmd) if dry_run else f"  {os.path.basename(cmd[0])} {cmd[-1]}")
+    if not dry_run:
+        subprocess.run(cmd, check=True)
+
+
+def build(args, targets):
+    cl430 = os.path.join(args.cgt, "bin", "cl430")
+    ar430 = os.path.join(args.cgt, "bin", "ar430")
+    includes = [f"--include_path={d}" for d in (args.device_include,
+                                                 os.path.join(args.cgt, "include"), ROOT)]
+
+    def compile_to(build_dir, src):
+        if not args.dry_run:
+            os.makedirs(build_dir, exist_ok=True)
+        run([cl430] + CFLAGS + includes + ["--compile_only",
+            f"--obj_directory={build_dir}", os.path.join(ROOT, src)], args.dry_run)
+        return obj_name(build_dir, src)
+
+    lib_dir = os.path.join(args.build_dir, "lib")
+    library = os.path.join(args.build_dir, LIBRARY)
+    objects = [compile_to(lib_dir, src) for src in library_sources()]
+    if os.path.exists(library) and not args.dry_run:
+        os.remove(library)
+    run([ar430, "r", library] + objects, args.dry_run)
+
+    maps = {}
+    for name in targets:
+        sources = TARGETS[name][0]
+        target_dir = os.path.join(args.build_dir, name)
+        objects = [compile_to(target_dir, src) for src in sources]
+        maps[name] = os.path.join(target_dir, name + ".map")
+        run([cl430] + CFLAGS + ["--run_linker", "--rom_model",
+            "--unused_section_elimination=on", f"--stack_size={STACK_SIZE}",
+            "--heap_size=0", "--reread_libs", "--warn_sections",
+            f"--search_path={os.path.join(args.cgt, 'lib')}",
+            f"--search_path={args.device_include}",
+            f"--map_file={maps[name]}", f"--output_file={os.path.join(target_dir, name + '.out')}",
+            LINKER_CMD] + objects + [library, "--library=libc.a"], args.dry_run)
+    return maps
+
+
+def parse_map(path):
+    """Memory regions {name: (origin, length, used)} and per-module bytes
+    {module: {region: bytes}} from a TI linker map."""
+    regions = {}
+    modules = {}
+    part = None
+    section = None
+    run_offset = None
+
+    def region_of(addr):
+        for name, (origin, length, _) in regions.items():
+            if origin <= addr < origin + length:
+                return name
+        return None
+
+    def module_of(desc):
+        if section == ".stack":
+            return "stack"
+        m = re.match(r"(?:(\S+) : )?(\S+?)(?:\.c)?\.obj \(", desc)
+        if not m:
+            return "linker"                # .cinit tables, handler tables
+        if m.group(1) and m.group(1) != LIBRARY:
+            return "runtime"
+        return m.group(2)
+
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("MEMORY CONFIGURATION"):
+                part = "memory"
+                continue
+            if line.startswith("SECTION ALLOCATION MAP"):
+                part = "sections"
+                continue
+            if line.startswith(("GLOBAL SYMBOLS", "MODULE SUMMARY", "LINKER GENERATED")):
+                part = None
+                continue
+
+            if part == "memory":
+                m = re.match(r"\s+(\w+)\s+([0-9a-f]{8})\s+([0-9a-f]{8})\s+([0-9a-f]{8})\s", line)
+                if m:
+                    regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16), int(m.group(4), 16))
+            elif part == "sections":
+                if line and not line[0].isspace():
+                    # Output section header, its numbers possibly on a '*' line
+                    if not line.startswith("*"):
+                        section = line.split()[0]
+                    if "COPY SECTION" in line or "DSECT" in line:
+                        section = None
+                    m = re.search(r"\s([0-9a-f]{8})\s.*RUN ADDR = ([0-9a-f]{8})", line)
+                    run_offset = int(m.group(2), 16) - int(m.group(1), 16) if m else None
+                    continue
+                m = re.match(r"\s+([0-9a-f]{8})\s+([0-9a-f]{8})\s+(.*)$", line)
+                if not m or section is None or m.group(3).startswith("--HOLE--"):
+                    continue
+                addr, size = int(m.group(1), 16), int(m.group(2), 16)
+                usage = modules.setdefault(module_of(m.group(3)), {})
+                for where in [addr] + ([addr + run_offset] if run_offset is not None else []):
+                    region = region_of(where)
+                    if region:
+                        usage[region] = usage.get(region, 0) + size
+    return regions, modules
+
+
+def symbol_sizes(image, nm):
+    """Code symbol sizes from an ELF image; RAMFUNC code has a load and a
+    run symbol, the larger is kept."""
+    out = subprocess.run([nm, "--print-size", "--defined-only", image],
+                         check=True, capture_output=True, text=True).stdout
+    sizes = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2].lower() == "t":
+            sizes[fields[3]] = max(sizes.get(fields[3], 0), int(fields[1], 16))
+    return sizes
+
+
+def definitions(funcs):
+    """Source definition line of each routine that has one."""
+    found = {}
+    for path in glob.glob(os.path.join(ROOT, "*.c")):
+        with open(path, errors="replace") as f:
+            text = f.read()
+        for func in funcs:
+            m = re.search(r"^[^;{}\n]*\b" + re.escape(func) + r"\s*\([^;{}]*\)\s*\{", text, re.M)
+            if m and func not in found:
+                found[func] = m.group(0)
+    return found
+
+
+def report_hot_paths(name, map_path, nm):
+    """Print hot path sizes; returns the number of missing ISRs and
+    routines no source defines."""
+    image = os.path.splitext(map_path)[0] + ".out"
+    if not os.path.exists(image):
+        print(f"  hot paths: {os.path.relpath(image)} not found")
+        return 1
+    sizes = symbol_sizes(image, nm)
+    defined = definitions(HOT_PATHS[name])
+    failures = 0
+    print(f"  {'hot path':<26} {'bytes':>7}")
+    for func in HOT_PATHS[name]:
+        if func in sizes:
+            size = sizes[func]
+        elif func not in defined:
+            size = "NOT IN SOURCES"
+            failures += 1
+        elif "__interrupt" in defined[func]:
+            size = "MISSING"
+            failures += 1
+        else:
+            size = "inlined"
+        print(f"  {func:<26} {size:>7}")
+    print()
+    return failures
+
+
+def split(usage):
+    ram = sum(v for r, v in usage.items() if r in RAM_REGIONS)
+    return sum(usage.values()) - ram, ram
+
+
+def report(name, map_path, nm):
+    """Print the module table and hot paths; returns the number of failures."""
+    _, flash_budget, ram_budget = TARGETS[name]
+    regions, modules = parse_map(map_path)
+    failures = 0
+
+    print(f"{name} ({os.path.relpath(map_path)})")
+    print(f"  {'module':<20} {'flash':>7} {'RAM':>7}")
+    for module, usage in sorted(modules.items(), key=lambda kv: -sum(kv[1].values())):
+        flash, ram = split(usage)
+        note = ""
+        if module in MODULE_BUDGETS:
+            max_flash, max_ram = MODULE_BUDGETS[module]
+            if flash > max_flash or ram > max_ram:
+                note = f"  OVER module budget {max_flash}/{max_ram}"
+                failures += 1
+        print(f"  {module:<20} {flash:>7} {ram:>7}{note}")
+
+    # Totals from the region fill, which includes alignment holes
+    flash, ram = split({r: used for r, (_, _, used) in regions.items()})
+    over = flash > flash_budget or ram > ram_budget
+    print(f"  {'total':<20} {flash:>7} {ram:>7}  budget {flash_budget}/{ram_budget}"
+          f"{'  OVER' if over else ''}\n")
+    if name in HOT_PATHS:
+        failures += report_hot_paths(name, map_path, nm)
+    return failures + over
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("targets", nargs="*", metavar="target")
+    ap.add_argument("--list", action="store_true", help="list targets and budgets")
+    ap.add_argument("--dry-run", action="store_true", help="print the build commands")
+    ap.add_argument("--map", help="report this map file for a single target")
+    ap.add_argument("--build-dir", default=os.path.join(ROOT, "build"))
+    ap.add_argument("--cgt", default=os.environ.get("MSP430_CGT", ""))
+    ap.add_argument("--device-include", default=os.environ.get("MSP430_INCLUDE", ""))
+    ap.add_argument("--nm", default="nm", help="GNU nm for the hot path sizes")
+    args = ap.parse_args()
+
+    targets = args.targets or list(TARGETS)
+    unknown = [t for t in targets if t not in TARGETS]
+    if unknown:
+        ap.error(f"unknown target {', '.join(unknown)}; known: {', '.join(TARGETS)}")
+
+    if args.list:
+        for name, (sources, flash, ram) in TARGETS.items():
+            print(f"{name:<15} flash {flash:>6}  RAM {ram:>5}  {' '.join(sources)}")
+        return
+
+    if args.map:
+        if len(args.targets) != 1:
+            ap.error("--map needs exactly one target")
+        sys.exit(1 if report(targets[0], args.map, args.nm) else 0)
+
+    if not args.dry_run and (not args.cgt or not args.device_include):
+        ap.error("set --cgt/$MSP430_CGT and --device-include/$MSP430_INCLUDE")
+    maps = build(args, targets)
+    if args.dry_run:
+        return
+    failures = sum(report(name, path, args.nm) for name, path in maps.items())
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Decode the FRAM sensor history log (history.h) into CSV.
+
+Input is a raw binary dump of the historyLog array, e.g. saved from the
+CCS memory browser. Blocks are printed oldest first; a block cut short
+by a reset decodes up to its last complete record.
+
+    history_decode.py dump.bin [--block-bytes 128] > history.csv
+"""
+import argparse
+import struct
+import sys
+
+KEY_BYTES = 15
+SIGNALS = 3
+
+
+def varint(data, pos):
+    value = shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def decode_block(block):
+    seq, used, period, boot, time_s, flame, room, valve = struct.unpack_from("<HBBHIHhB", block)
+    values = [flame, room & 0xFFFF, valve]
+    rows = []
+
+    def emit():
+        room_c = (values[1] - 0x10000 if values[1] & 0x8000 else values[1]) / 100.0
+        rows.append((boot, time_s + period * len(rows), values[0], room_c, values[2]))
+
+    emit()
+    pos = KEY_BYTES
+    used = min(used, len(block))
+    try:
+        while pos < used:
+            mask = block[pos]
+            pos += 1
+            for i in range(SIGNALS):
+                if mask & (1 << i):
+                    delta, pos = varint(block, pos)
+                    values[i] = (values[i] + unzigzag(delta)) & 0xFFFF
+            if pos > used:
+                break
+            emit()
+    except IndexError:
+        pass                       # Truncated record at the end of the block
+    return seq, rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump")
+    parser.add_argument("--block-bytes", type=int, default=128)
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+
+    blocks = []
+    for offset in range(0, len(data) - args.block_bytes + 1, args.block_bytes):
+        block = data[offset:offset + args.block_bytes]
+        if block[2] < KEY_BYTES:
+            continue               # Never written
+        blocks.append(decode_block(block))
+
+    # Sequence numbers wrap at 16 bits; the oldest block follows the
+    # largest gap in the cyclic order
+    blocks.sort(key=lambda b: b[0])
+    if blocks:
+        gaps = [((blocks[(i + 1) % len(blocks)][0] - blocks[i][0]) & 0xFFFF, i) for i in range(len(blocks))]
+        start = (max(gaps)[1] + 1) % len(blocks)
+        blocks = blocks[start:] + blocks[:start]
+
+    out = sys.stdout
+    out.write("boot,time_s,flame_adc,room_c,valve_pct\n")
+    for _, rows in blocks:
+        for boot, time_s, flame, room_c, valve in rows:
+            out.write("%d,%d,%d,%.2f,%d\n" % (boot, time_s, flame, room_c, valve))
+
+
+if __name__ == "__main__":
+    main()
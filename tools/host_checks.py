@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Build and run the host-side checks of firmware modules.
+
+Each check is a small C program in tools/ linked with the unmodified
+module sources it exercises. Sources that touch registers build
+against the host shim in tools/plant_sim/msp430.h. A check passes when
+its program exits 0.
+
+    host_checks.py                  run every check
+    host_checks.py queue [...]      run the named checks
+    host_checks.py --list
+"""
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SHIM_DIR = os.path.join(ROOT, "tools", "plant_sim")
+
+# name: (sources relative to the repository root, extra link flags, what it checks)
+CHECKS = {
+    "queue": (["tools/queue_bench.c", "spsc_queue.c"], ["-lrt"],
+              "SPSC queue ordering under preemption, throughput"),
+    "i2c": (["tools/i2c_master.c", "i2c_target.c"], ["-fsanitize=undefined", "-fno-sanitize-recover"],
+            "I2C target register map against a stand-in bus master"),
+    "conversion": (["tools/conversion_bench.c", "ADC.c", "thermistor.c", "thermocouple.c",
+                    "Potentiometer.c", "fixmath.c", "acquire.c", "events.c", "spsc_queue.c",
+                    "metrics.c", "timebase.c", "tools/plant_sim/mcu.c"], [],
+                   "Sensor conversions over all 4096 codes against a double reference"),
+}
+
+
+def build(name, build_dir, cc):
+    sources, ldflags, _ = CHECKS[name]
+    binary = os.path.join(build_dir, name)
+    os.makedirs(build_dir, exist_ok=True)
+    # The shim directory goes first so <msp430.h> is the host one
+    cmd = [cc, "-O2", "-std=gnu99", "-Wall", "-Wno-unknown-pragmas", "-Wno-main",
+           "-I", SHIM_DIR, "-I", ROOT, "-o", binary] + \
+          [os.path.join(ROOT, s) for s in sources] + ldflags + ["-lm"]
+    subprocess.run(cmd, check=True)
+    return binary
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("checks", nargs="*", metavar="check")
+    ap.add_argument("--list", action="store_true")
+    ap.add_argument("--build-dir", default=os.path.join(tempfile.gettempdir(), "host_checks"))
+    ap.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    args = ap.parse_args()
+
+    if args.list:
+        for name, (_, _, what) in CHECKS.items():
+            print(f"{name:<12} {what}")
+        return
+
+    names = args.checks or list(CHECKS)
+    unknown = [n for n in names if n not in CHECKS]
+    if unknown:
+        ap.error(f"unknown check {', '.join(unknown)}; known: {', '.join(CHECKS)}")
+
+    failed = []
+    for name in names:
+        print(f"== {name}")
+        sys.stdout.flush()
+        if subprocess.run([build(name, args.build_dir, args.cc)]).returncode != 0:
+            failed.append(name)
+    if failed:
+        print(f"FAILED: {', '.join(failed)}")
+        sys.exit(1)
+    print(f"all {len(names)} passed")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,165 @@
+#include "i2c_target.h"
+#include <msp430.h>
+#include <stdio.h>
+#include <string.h>
+
+// Host stand-in for the I2C bus master, driving i2c_target.c:
+//
+//     i2c_master
+//
+// Each transfer is the interrupt sequence eUSCI_B1 raises for it (START,
+// one RX or TX per byte, STOP), fed straight into EUSCI_B1_ISR with
+// UCB1IV and the data registers set as the peripheral would set them.
+// Covers reads across and past the end of the map, writes at every
+// pointer, and 16-bit registers written one byte at a time.
+//
+// Exits 1 on any mismatch.
+
+volatile uint8_t P4SEL0, P4SEL1;
+volatile uint16_t UCB1CTLW0, UCB1I2COA0, UCB1IE, UCB1IV, UCB1RXBUF, UCB1TXBUF;
+
+void EUSCI_B1_ISR(void);
+
+// Single context: nothing to mask
+void __disable_interrupt(void) {}
+uint16_t __get_interrupt_state(void) { return 0; }
+void __set_interrupt_state(uint16_t state) { (void)state; }
+
+static unsigned failures;
+
+static void Check(int ok, const char *what) {
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void Raise(uint16_t iv) {
+    UCB1IV = iv;
+    EUSCI_B1_ISR();
+}
+
+// Write transfer: pointer byte, then data bytes from it
+static void Write(uint8_t pointer, const uint8_t *data, unsigned count) {
+    unsigned i;
+
+    Raise(USCI_I2C_UCSTTIFG);
+    UCB1RXBUF = pointer;
+    Raise(USCI_I2C_UCRXIFG0);
+    for (i = 0; i < count; i++) {
+        UCB1RXBUF = data[i];
+        Raise(USCI_I2C_UCRXIFG0);
+    }
+    Raise(USCI_I2C_UCSTPIFG);
+}
+
+// Combined transfer: pointer write, repeated START, read
+static void Read(uint8_t pointer, uint8_t *data, unsigned count) {
+    unsigned i;
+
+    Raise(USCI_I2C_UCSTTIFG);
+    UCB1RXBUF = pointer;
+    Raise(USCI_I2C_UCRXIFG0);
+    Raise(USCI_I2C_UCSTTIFG);
+    for (i = 0; i < count; i++) {
+        Raise(USCI_I2C_UCTXIFG0);
+        data[i] = (uint8_t)UCB1TXBUF;
+    }
+    Raise(USCI_I2C_UCSTPIFG);
+}
+
+static void Reads(void) {
+    RegisterMap map;
+    uint8_t bytes[sizeof(RegisterMap) + 4];
+    unsigned i, start;
+
+    for (i = 0; i < sizeof(map); i++) ((uint8_t *)&map)[i] = (uint8_t)(0xA0 + i);
+    I2CTarget_Publish(&map);
+
+    // From every pointer, running off the end: map bytes, then 0xFF
+    for (start = 0; start <= sizeof(map); start++) {
+        Read((uint8_t)start, bytes, sizeof(bytes));
+        for (i = 0; i < sizeof(bytes); i++) {
+            uint8_t expect = (start + i < sizeof(map)) ? (uint8_t)(0xA0 + start + i) : 0xFF;
+            if (bytes[i] != expect) {
+                printf("read from 0x%02X, byte %u: 0x%02X, expected 0x%02X\n",
+                       start, i, bytes[i], expect);
+                failures++;
+                break;
+            }
+        }
+    }
+
+    // Pointers far past the end, including ones the pointer would wrap from
+    Read(0xFE, bytes, 8);
+    for (i = 0; i < 8; i++) Check(bytes[i] == 0xFF, "read past 0xFF returns 0xFF");
+}
+
+static void Writes(void) {
+    static const uint8_t all[4] = { 1, 55, 0x34, 0x12 };
+    uint8_t junk[300];
+    RegisterWrites w;
+    unsigned pointer;
+
+    // The whole writable block in one transfer
+    Write(REG_HEAT_DEMAND, all, 4);
+    Check(I2CTarget_TakeWrites(&w), "full write committed");
+    Check(w.mask == REG_WRITABLE_MASK, "full write mask");
+    Check(w.heatDemand == 1 && w.firingRate == 55 && w.targetTemp == 0x1234, "full write values");
+    Check(!I2CTarget_TakeWrites(&w), "writes taken once");
+
+    // One byte at every pointer, read-only and past the end included
+    for (pointer = 0; pointer <= 0xFF; pointer++) {
+        uint8_t expectMask = (pointer == REG_HEAT_DEMAND || pointer == REG_FIRING_RATE);
+        Write((uint8_t)pointer, all, 1);
+        if (I2CTarget_TakeWrites(&w)) {
+            if (!expectMask || w.mask != (1U << pointer)) {
+                printf("single byte at 0x%02X committed mask 0x%04X\n", pointer, w.mask);
+                failures++;
+            }
+        } else if (expectMask) {
+            printf("single byte at 0x%02X not committed\n", pointer);
+            failures++;
+        }
+    }
+
+    // A long write from the end of the map must not wrap into 0x02-0x05
+    memset(junk, 0x77, sizeof(junk));
+    Write(sizeof(RegisterMap) - 1, junk, sizeof(junk));
+    Check(!I2CTarget_TakeWrites(&w), "long write past the end ignored");
+    Write(0xFF, junk, sizeof(junk));
+    Check(!I2CTarget_TakeWrites(&w), "write at pointer 0xFF ignored");
+
+    // Half of targetTemp: low byte only, high byte only
+    Write(REG_TARGET_TEMP, all + 2, 1);
+    Check(!I2CTarget_TakeWrites(&w), "targetTemp low byte alone ignored");
+    Write(REG_TARGET_TEMP + 1, all + 3, 1);
+    Check(!I2CTarget_TakeWrites(&w), "targetTemp high byte alone ignored");
+
+    // Firing rate plus the low byte: only the rate lands
+    Write(REG_FIRING_RATE, all + 1, 2);
+    Check(I2CTarget_TakeWrites(&w) && w.mask == (1U << REG_FIRING_RATE) && w.firingRate == 55,
+          "rate plus half of targetTemp commits the rate only");
+
+    // Low byte in one transfer, high byte in the next, main loop not
+    // taking in between: still not a value
+    Write(REG_TARGET_TEMP, all + 2, 1);
+    Write(REG_TARGET_TEMP + 1, all + 3, 1);
+    Check(!I2CTarget_TakeWrites(&w), "targetTemp split over two transfers ignored");
+
+    // Writes that arrive while the main loop holds the last set are kept
+    // and handed over once the main loop takes the previous set
+    Write(REG_HEAT_DEMAND, all, 1);
+    Write(REG_TARGET_TEMP, all + 2, 2);
+    Check(I2CTarget_TakeWrites(&w) && w.mask == (1U << REG_HEAT_DEMAND), "first set");
+    Check(I2CTarget_TakeWrites(&w) && w.mask == (3U << REG_TARGET_TEMP) && w.targetTemp == 0x1234,
+          "second set held until taken");
+}
+
+int main(void) {
+    I2CTarget_Init();
+    Reads();
+    Writes();
+    printf("i2c master: %u failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Closed-loop burner/room simulation of the controller on the host.
+
+Builds the controller sources unchanged against a host register shim
+(tools/plant_sim/msp430.h) and links them with a model of the flame,
+heat exchanger, room, sensors and thermostat (tools/plant_sim/). The
+controller sees the plant only through its ADC channels, the P4.1
+heat request/thermostat link and the pilot, spark and main valve
+outputs. Time only passes while the controller sleeps, so runs take
+seconds per simulated day.
+
+    plant_sim.py [name=value ...]                  one run, full report
+    plant_sim.py --compare [name=value ...]        strategies side by side
+    plant_sim.py --sweep kp=10,20,40 [name=value ...]
+    plant_sim.py --trip-check [name=value ...]     exits 1 if a trip reopens gas
+
+Parameters (defaults in plant.c Plant_Defaults): hours setpoint room_init
+outdoor band seed, burner_kw pilot_kw efficiency ignite_delay ignite_prob,
+tc_lit_mv tc_cold_mv tc_heat_tau tc_cool_tau tc_noise_mv, hx_tau hx_ua
+room_tau room_ua (s, kW/K), sensor_tau sensor_noise, strategy=onoff|
+modulating pot diff stat_tau kp ti mod_min frame, min_burn min_off merge
+pilot_hold (s, demand.h), trip trip_len (s, safety switch opened at trip
+for trip_len), trigger=timer|software, trace=<csv> trace_period.
+"""
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SIM_DIR = os.path.join(ROOT, "tools", "plant_sim")
+
+# Production controller modules. selftest.c walks absolute SRAM/FRAM
+# addresses and is replaced by a stub in mcu.c.
+CONTROLLER_SOURCES = [
+    "main.c", "ADC.c", "Pilot_Valve.c", "Potentiometer.c", "acquire.c", "boot.c",
+    "demand.c", "events.c", "fixmath.c", "fram.c", "history.c", "i2c_target.c",
+    "igniter.c", "ignition.c", "main_valve.c", "metrics.c", "outputs.c",
+    "ramfunc.c", "sampling.c", "spsc_queue.c", "status_led.c", "thermistor.c",
+    "thermocouple.c", "thermostat.c", "timebase.c",
+]
+SIM_SOURCES = ["mcu.c", "plant.c", "sim.c"]
+
+# The controller's main(), called from sim.c
+RENAME_MAIN = {
+    "main.c": "controller_main",
+}
+
+COMPARE = [
+    ("on/off, pot 100%", ["strategy=onoff", "pot=100"]),
+    ("on/off, pot 60%", ["strategy=onoff", "pot=60"]),
+    ("on/off, no demand shaping", ["strategy=onoff", "min_burn=0", "min_off=0", "merge=0"]),
+    ("modulating kp=40 ti=1800", ["strategy=modulating", "kp=40", "ti=1800"]),
+    ("modulating kp=20 ti=3600", ["strategy=modulating", "kp=20", "ti=3600"]),
+]
+
+# Safety trips every TRIP_STEP_S through the first burner start (prepurge,
+# ignition, prove, main valve), brief (latched event) and held open
+TRIP_END_S = 15
+TRIP_STEP_S = 0.25
+TRIP_LENGTHS = [0.05, 5]
+
+COLUMNS = [
+    ("settle min", "settling_s", lambda v: "-" if float(v) < 0 else f"{float(v) / 60:.1f}"),
+    ("overshoot K", "overshoot_k", lambda v: f"{float(v):.2f}"),
+    ("rms K", "tail_rms_k", lambda v: f"{float(v):.2f}"),
+    ("gas kWh", "gas_kwh", lambda v: f"{float(v):.1f}"),
+    ("ignitions", "spark_trains", str),
+    ("burns", "burner_starts", str),
+    ("main h", "main_h", lambda v: f"{float(v):.2f}"),
+    ("end", "end_state", str),
+]
+
+
+def build(build_dir, cc):
+    binary = os.path.join(build_dir, "plant_sim")
+    sources = [os.path.join(ROOT, s) for s in CONTROLLER_SOURCES] + \
+              [os.path.join(SIM_DIR, s) for s in SIM_SOURCES]
+    headers = [os.path.join(d, f) for d in (ROOT, SIM_DIR) for f in os.listdir(d) if f.endswith(".h")]
+    if os.path.exists(binary):
+        built = os.path.getmtime(binary)
+        if all(os.path.getmtime(f) < built for f in sources + headers):
+            return binary
+
+    os.makedirs(build_dir, exist_ok=True)
+    objects = []
+    for src in sources:
+        name = os.path.basename(src)
+        obj = os.path.join(build_dir, name[:-2] + ".o")
+        # The shim directory goes first so <msp430.h> is the host one
+        cmd = [cc, "-O2", "-std=gnu99", "-Wall", "-Wno-unknown-pragmas", "-Wno-main",
+               "-I", SIM_DIR, "-I", ROOT, "-c", src, "-o", obj]
+        if name in RENAME_MAIN and os.path.dirname(src) == ROOT:
+            cmd.insert(1, f"-Dmain={RENAME_MAIN[name]}")
+        subprocess.run(cmd, check=True)
+        objects.append(obj)
+    subprocess.run([cc, "-o", binary] + objects + ["-lm"], check=True)
+    return binary
+
+
+def run(binary, args):
+    out = subprocess.run([binary, "format=kv"] + args, check=True,
+                         capture_output=True, text=True).stdout
+    return dict(field.split("=", 1) for field in out.split())
+
+
+def table(rows):
+    header = ["case"] + [title for title, _, _ in COLUMNS]
+    cells = [[name] + [fmt(result[key]) for _, key, fmt in COLUMNS] for name, result in rows]
+    widths = [max(len(row[i]) for row in [header] + cells) for i in range(len(header))]
+    for row in [header] + cells:
+        print("  ".join(cell.ljust(w) if i == 0 else cell.rjust(w)
+                        for i, (cell, w) in enumerate(zip(row, widths))))
+
+
+def trip_check(binary, params):
+    """Pilot must stay closed on every pass from the trip until IDLE."""
+    failures = 0
+    for length in TRIP_LENGTHS:
+        runs = 0
+        for i in range(1, int(TRIP_END_S / TRIP_STEP_S) + 1):
+            at = i * TRIP_STEP_S
+            r = run(binary, [f"hours={(at + length + 10) / 3600}", f"trip={at}",
+                             f"trip_len={length}"] + params)
+            runs += 1
+            if r["trip_closed"] != "1" or float(r["trip_reopen_s"]) > 0:
+                print(f"trip at {at:.2f} s for {length} s: closed={r['trip_closed']} "
+                      f"reopened {r['trip_reopen_s']} s")
+                failures += 1
+        print(f"trips of {length} s: {runs} runs")
+    print(f"trip check: {failures} failures")
+    return failures
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--compare", action="store_true", help="run the preset strategies")
+    ap.add_argument("--sweep", metavar="NAME=V1,V2,...", help="one run per value")
+    ap.add_argument("--trip-check", action="store_true", help="safety trips through a start")
+    ap.add_argument("--build-dir", default=os.path.join(tempfile.gettempdir(), "plant_sim"))
+    ap.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    ap.add_argument("params", nargs="*", metavar="name=value")
+    args = ap.parse_args()
+
+    binary = build(args.build_dir, args.cc)
+
+    if args.trip_check:
+        sys.exit(1 if trip_check(binary, args.params) else 0)
+    elif args.compare:
+        table([(name, run(binary, preset + args.params)) for name, preset in COMPARE])
+    elif args.sweep:
+        name, values = args.sweep.split("=", 1)
+        table([(f"{name}={v}", run(binary, args.params + [f"{name}={v}"])) for v in values.split(",")])
+    else:
+        sys.exit(subprocess.run([binary] + args.params).returncode)
+
+
+if __name__ == "__main__":
+    main()
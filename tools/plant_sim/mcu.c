@@ -0,0 +1,238 @@
+#include "sim.h"
+#include "selftest.h"
+#include "system_state.h"
+#include <msp430.h>
+
+// Just enough of the MSP430FR2355 for the controller: register storage,
+// interrupt dispatch and the timer events that drive it. Code runs in
+// zero simulated time; time only passes while the CPU sits in LPM0.
+
+// Registers
+volatile uint16_t WDTCTL, PM5CTL0, SYSCFG0, SYSRSTIV;
+volatile uint8_t P1IN, P1OUT, P1DIR, P1SEL0, P1SEL1;
+volatile uint8_t P2IN, P2OUT, P2DIR, P2REN, P2SEL0, P2SEL1, P2IES, P2IE, P2IFG;
+volatile uint8_t P4IN, P4OUT, P4DIR, P4REN, P4SEL0, P4SEL1, P4IES, P4IE, P4IFG;
+volatile uint8_t P5IN, P5OUT, P5DIR;
+volatile uint8_t P6OUT, P6DIR, P6SEL0, P6SEL1;
+volatile uint16_t PAOUT, PADIR, PASEL0, PASEL1, PAREN, PAIES, PAIE, PAIFG;
+volatile uint16_t PBOUT, PBREN, PBIES, PBIE, PBIFG, PBSEL0;
+volatile uint16_t PCOUT, PCDIR, PCSEL0;
+volatile uint16_t ADCCTL0, ADCCTL1, ADCCTL2, ADCMCTL0, ADCMEM0;
+volatile uint16_t ADCIE, ADCIFG, ADCIV, ADCLO, ADCHI;
+volatile uint16_t SAC0OA, SAC0PGA;
+volatile uint16_t TA0CTL, TA0R, TA0IV, TA0CCTL0, TA0CCR0, TA0CCTL1, TA0CCR1;
+volatile uint16_t TB0CTL, TB0CCR0, TB0CCTL1, TB0CCR1;
+volatile uint16_t TB1CTL, TB1CCTL0, TB1CCR0, TB1CCTL1, TB1CCR1, TB1CCTL2, TB1CCR2;
+volatile uint16_t TB2CTL, TB2R;
+volatile uint16_t TB3CTL, TB3IV, TB3CCR0, TB3CCTL1, TB3CCR1, TB3CCTL2, TB3CCR2, TB3CCTL3, TB3CCR3;
+volatile uint16_t CRCINIRES, CRCDI;
+volatile uint16_t UCB1CTLW0, UCB1I2COA0, UCB1IE, UCB1IV, UCB1RXBUF, UCB1TXBUF;
+
+// Linker-generated symbols (ramfunc.c)
+char ram_data_start, ram_data_end, __STACK_SIZE;
+
+uint64_t simNow = 0;
+
+static uint16_t statusReg = 0;
+static uint8_t wake = 0;
+
+// Controller ISRs
+void Timer_A0_ISR(void);
+void Timer_A1_ISR(void);
+void ADC_ISR(void);
+void MainValve_ISR(void);
+void Port_2_ISR(void);
+void Port_4_ISR(void);
+
+// The self-test walks absolute SRAM and FRAM addresses, which do not
+// exist here; it never finds a fault
+SelfTestStats selfTestStats;
+
+void SelfTest_Init(void) {
+}
+
+uint8_t SelfTest_Step(void) {
+    return LOCKOUT_NONE;
+}
+
+void __enable_interrupt(void) {
+    statusReg |= GIE;
+}
+
+void __disable_interrupt(void) {
+    statusReg &= ~GIE;
+}
+
+uint16_t __get_interrupt_state(void) {
+    return statusReg & GIE;
+}
+
+void __set_interrupt_state(uint16_t state) {
+    statusReg = (statusReg & ~GIE) | (state & GIE);
+}
+
+void __delay_cycles(uint32_t cycles) {
+    (void)cycles;
+}
+
+void __no_operation(void) {
+}
+
+void __bic_SR_register_on_exit(uint16_t bits) {
+    if (bits & LPM0_bits) wake = 1;
+}
+
+static void UpdateCounters(void) {
+    TA0R = (uint16_t)(simNow / SIM_ACLK_UNITS);
+    TB2R = (uint16_t)(simNow / SIM_TB2_UNITS);
+}
+
+// Window comparator flag first, then the result, in ADCIV order
+static void AdcServe(void) {
+    uint16_t pending;
+
+    while ((pending = ADCIFG & ADCIE) != 0) {
+        if (pending & ADCLOIFG) {
+            ADCIFG &= ~ADCLOIFG;
+            ADCIV = ADCIV_ADCLOIFG;
+        } else if (pending & ADCIFG0) {
+            ADCIFG &= ~ADCIFG0;
+            ADCIV = ADCIV_ADCIFG;
+        } else {
+            break;
+        }
+        ADC_ISR();
+        ADCIV = ADCIV_NONE;
+    }
+}
+
+static void AdcConvert(void) {
+    ADCMEM0 = Plant_AdcCode(ADCMCTL0 & ADCINCH_15);
+    if (ADCMEM0 < ADCLO) ADCIFG |= ADCLOIFG;
+    ADCIFG |= ADCIFG0;
+    AdcServe();
+}
+
+// Software start (ADCSC in msp430.h)
+void Sim_AdcStart(void) {
+    if (ADCCTL0 & ADCON) AdcConvert();
+}
+
+// Next rising edge of TB1.1 (set at CCR0 in reset/set mode) while it
+// triggers conversions, else 0
+static uint64_t NextAdcTrigger(void) {
+    uint64_t period, phase;
+
+    if (!(ADCCTL0 & ADCON) || !(ADCCTL0 & ADCENC)) return 0;
+    if ((ADCCTL1 & ADCSHS_3) != ADCSHS_2) return 0;
+    if ((TB1CTL & MC_3) != MC__UP || (TB1CCTL1 & OUTMOD_7) != OUTMOD_7) return 0;
+
+    period = ((uint64_t)TB1CCR0 + 1) * SIM_SMCLK_UNITS;
+    phase = (uint64_t)TB1CCR0 * SIM_SMCLK_UNITS;
+    if (simNow < phase) return phase;
+    return phase + ((simNow - phase) / period + 1) * period;
+}
+
+// TB1 reaching CCR0 while its interrupt is enabled (valve moves), else 0
+static uint64_t NextValvePeriod(void) {
+    uint64_t period, phase;
+
+    if (!(TB1CCTL0 & CCIE) || (TB1CTL & MC_3) != MC__UP) return 0;
+
+    period = ((uint64_t)TB1CCR0 + 1) * SIM_SMCLK_UNITS;
+    phase = (uint64_t)TB1CCR0 * SIM_SMCLK_UNITS;
+    if (simNow < phase) return phase;
+    return phase + ((simNow - phase) / period + 1) * period;
+}
+
+// TA0 CCR0 compare, else 0
+static uint64_t NextCompare(void) {
+    uint64_t ticks = simNow / SIM_ACLK_UNITS;
+    uint32_t ahead;
+
+    if (!(TA0CCTL0 & CCIE)) return 0;
+    ahead = (uint16_t)(TA0CCR0 - (uint16_t)ticks);
+    if (!ahead) ahead = 0x10000;
+    return (ticks + ahead) * SIM_ACLK_UNITS;
+}
+
+// TA0 overflow with TAIE, else 0
+static uint64_t NextOverflow(void) {
+    uint64_t ticks = simNow / SIM_ACLK_UNITS;
+
+    if (!(TA0CTL & TAIE) || (TA0CTL & MC_3) != MC__CONTINUOUS) return 0;
+    return (((ticks >> 16) + 1) << 16) * SIM_ACLK_UNITS;
+}
+
+static void Earliest(uint64_t *next, uint64_t when) {
+    if (when && when < *next) *next = when;
+}
+
+// LPM0: run timers, conversions and the plant until an ISR clears LPM0
+static void Sleep(void) {
+    uint64_t compare, overflow, trigger, valve, plantDue, next;
+
+    wake = 0;
+    while (!wake) {
+        compare = NextCompare();
+        overflow = NextOverflow();
+        trigger = NextAdcTrigger();
+        valve = NextValvePeriod();
+        plantDue = Plant_Next();
+
+        next = plantDue;
+        Earliest(&next, compare);
+        Earliest(&next, overflow);
+        Earliest(&next, trigger);
+        Earliest(&next, valve);
+        simNow = next;
+        UpdateCounters();
+
+        // Interrupt priority order: TA0 CCR0, TA0 IV, TB1 CCR0, ADC, ports
+        if (next == compare) {
+            TA0CCTL0 |= CCIFG;
+            Timer_A0_ISR();
+        }
+        if (next == overflow) {
+            TA0IV = TA0IV_TAIFG;           // Reading TA0IV clears TAIFG
+            Timer_A1_ISR();
+            TA0IV = 0;
+        }
+        if (next == valve) {
+            TB1CCTL0 |= CCIFG;
+            MainValve_ISR();
+        }
+        if (next == trigger) AdcConvert();
+        if (next == plantDue) Plant_Run();
+    }
+}
+
+void __bis_SR_register(uint16_t bits) {
+    statusReg |= bits & GIE;
+    if (bits & LPM0_bits) Sleep();
+}
+
+// Plant-driven input pin; edges raise the port interrupt like the pin
+// would. P4.1 edges are also captured by TA0 CCR1 (thermostat.c).
+void Mcu_PinInput(uint8_t port, uint8_t pin, uint8_t level) {
+    volatile uint8_t *in = (port == 4) ? &P4IN : &P2IN;
+    volatile uint8_t *ies = (port == 4) ? &P4IES : &P2IES;
+    volatile uint8_t *ie = (port == 4) ? &P4IE : &P2IE;
+    volatile uint8_t *ifg = (port == 4) ? &P4IFG : &P2IFG;
+    uint8_t was = (*in & pin) ? 1 : 0;
+
+    if (level == was) return;
+    *in = level ? (*in | pin) : (*in & ~pin);
+
+    // IES set = falling edge
+    if (((*ies & pin) ? 0 : 1) != level) return;
+    *ifg |= pin;
+    if (!(*ie & pin) || !(statusReg & GIE)) return;
+
+    if (port == 4) {
+        if (TA0CCTL1 & CAP) TA0CCR1 = TA0R;
+        Port_4_ISR();
+    } else {
+        Port_2_ISR();
+    }
+}
@@ -0,0 +1,164 @@
+#ifndef PLANT_SIM_MSP430_H_
+#define PLANT_SIM_MSP430_H_
+
+// Host stand-in for the TI device header, found ahead of the real one
+// by include order. Only what the controller sources use is declared.
+// Registers are plain variables owned by mcu.c; bit values match
+// msp430fr2355.h so register images decode the same way. The port
+// pairs (PAOUT = P1OUT/P2OUT, ...) are not aliased here: the simulator
+// always takes the full init path because its FRAM records start blank.
+
+#include <stdint.h>
+
+// Compiler keywords and intrinsics (mcu.c)
+#define __interrupt
+#define __even_in_range(value, bound)  (value)
+
+void __enable_interrupt(void);
+void __disable_interrupt(void);
+uint16_t __get_interrupt_state(void);
+void __set_interrupt_state(uint16_t state);
+void __bis_SR_register(uint16_t bits);         // LPMx: runs simulated time
+void __bic_SR_register_on_exit(uint16_t bits); // LPMx: ends the sleep
+void __delay_cycles(uint32_t cycles);
+void __no_operation(void);
+
+// Status register
+#define GIE         (0x0008)
+#define LPM0_bits   (0x0010)
+
+// Watchdog, PMM, SYS
+extern volatile uint16_t WDTCTL, PM5CTL0, SYSCFG0, SYSRSTIV;
+#define WDTPW       (0x5A00)
+#define WDTHOLD     (0x0080)
+#define LOCKLPM5    (0x0001)
+#define PFWP        (0x0001)
+#define DFWP        (0x0002)
+#define FRWPPW      (0xA500)
+#define SYSRSTIV_BOR      (0x0002)
+#define SYSRSTIV_SVSHIFG  (0x000E)
+
+// Digital I/O. P4IN and P2IN are driven by the plant.
+extern volatile uint8_t P1IN, P1OUT, P1DIR, P1SEL0, P1SEL1;
+extern volatile uint8_t P2IN, P2OUT, P2DIR, P2REN, P2SEL0, P2SEL1, P2IES, P2IE, P2IFG;
+extern volatile uint8_t P4IN, P4OUT, P4DIR, P4REN, P4SEL0, P4SEL1, P4IES, P4IE, P4IFG;
+extern volatile uint8_t P5IN, P5OUT, P5DIR;
+extern volatile uint8_t P6OUT, P6DIR, P6SEL0, P6SEL1;
+extern volatile uint16_t PAOUT, PADIR, PASEL0, PASEL1, PAREN, PAIES, PAIE, PAIFG;
+extern volatile uint16_t PBOUT, PBREN, PBIES, PBIE, PBIFG, PBSEL0;
+extern volatile uint16_t PCOUT, PCDIR, PCSEL0;
+
+#define BIT0        (0x0001)
+#define BIT1        (0x0002)
+#define BIT2        (0x0004)
+#define BIT3        (0x0008)
+#define BIT4        (0x0010)
+#define BIT5        (0x0020)
+#define BIT6        (0x0040)
+#define BIT7        (0x0080)
+
+// ADC. A software start converts at once: ADCSC runs the conversion
+// as a side effect of being evaluated, before readADC() waits on the
+// ADC queue. Nothing else may use ADCSC as a constant.
+extern volatile uint16_t ADCCTL0, ADCCTL1, ADCCTL2, ADCMCTL0, ADCMEM0;
+extern volatile uint16_t ADCIE, ADCIFG, ADCIV, ADCLO, ADCHI;
+void Sim_AdcStart(void);
+
+#define ADCSC       (Sim_AdcStart(), 0x0001)
+#define ADCENC      (0x0002)
+#define ADCON       (0x0010)
+#define ADCSHT_2    (0x0200)
+#define ADCSHT_8    (0x0800)
+#define ADCBUSY     (0x0001)
+#define ADCCONSEQ_2 (0x0004)
+#define ADCCONSEQ_3 (0x0006)
+#define ADCSHP      (0x0200)
+#define ADCSHS_2    (0x0800)
+#define ADCSHS_3    (0x0C00)
+#define ADCRES      (0x0030)
+#define ADCRES_2    (0x0020)
+#define ADCINCH_1   (0x0001)
+#define ADCINCH_3   (0x0003)
+#define ADCINCH_4   (0x0004)
+#define ADCINCH_5   (0x0005)
+#define ADCINCH_15  (0x000F)
+#define ADCIFG0     (0x0001)
+#define ADCINIFG    (0x0002)
+#define ADCLOIFG    (0x0004)
+#define ADCHIIFG    (0x0008)
+#define ADCIE0      (0x0001)
+#define ADCLOIE     (0x0004)
+#define ADCIV_NONE       (0x0000)
+#define ADCIV_ADCOVIFG   (0x0002)
+#define ADCIV_ADCTOVIFG  (0x0004)
+#define ADCIV_ADCHIIFG   (0x0006)
+#define ADCIV_ADCLOIFG   (0x0008)
+#define ADCIV_ADCINIFG   (0x000A)
+#define ADCIV_ADCIFG     (0x000C)
+
+// SAC0 thermocouple amplifier
+extern volatile uint16_t SAC0OA, SAC0PGA;
+#define PSEL_0      (0x0000)
+#define PMUXEN      (0x0008)
+#define NSEL_1      (0x0010)
+#define NMUXEN      (0x0080)
+#define OAEN        (0x0100)
+#define SACEN       (0x0400)
+#define MSEL_2      (0x0002)
+#define GAIN2       (0x0040)
+
+// Timers. TA0R and TB2R follow simulated time; every timer is taken to
+// start counting at time zero.
+extern volatile uint16_t TA0CTL, TA0R, TA0IV, TA0CCTL0, TA0CCR0, TA0CCTL1, TA0CCR1;
+extern volatile uint16_t TB0CTL, TB0CCR0, TB0CCTL1, TB0CCR1;
+extern volatile uint16_t TB1CTL, TB1CCTL0, TB1CCR0, TB1CCTL1, TB1CCR1, TB1CCTL2, TB1CCR2;
+extern volatile uint16_t TB2CTL, TB2R;
+extern volatile uint16_t TB3CTL, TB3IV, TB3CCR0, TB3CCTL1, TB3CCR1, TB3CCTL2, TB3CCR2, TB3CCTL3, TB3CCR3;
+
+#define TASSEL__ACLK    (0x0100)
+#define TBSSEL__ACLK    (0x0100)
+#define TBSSEL__SMCLK   (0x0200)
+#define ID__8           (0x00C0)
+#define MC__STOP        (0x0000)
+#define MC__UP          (0x0010)
+#define MC__CONTINUOUS  (0x0020)
+#define MC_3            (0x0030)
+#define TACLR           (0x0004)
+#define TBCLR           (0x0004)
+#define TAIE            (0x0002)
+#define TBIE            (0x0002)
+#define TAIFG           (0x0001)
+#define CCIFG           (0x0001)
+#define OUT             (0x0004)
+#define CCIE            (0x0010)
+#define OUTMOD_0        (0x0000)
+#define OUTMOD_3        (0x0060)
+#define OUTMOD_7        (0x00E0)
+#define CAP             (0x0100)
+#define CLLD_1          (0x0200)
+#define CCIS0           (0x1000)
+#define CCIS_2          (0x2000)
+#define CM_3            (0xC000)
+#define TA0IV_TAIFG     (0x000E)
+#define TB3IV_TBIFG     (0x000E)
+
+// CRC16: reads back the seed, there is no checksum engine
+extern volatile uint16_t CRCINIRES, CRCDI;
+
+// eUSCI_B1, never addressed in the simulator
+extern volatile uint16_t UCB1CTLW0, UCB1I2COA0, UCB1IE, UCB1IV, UCB1RXBUF, UCB1TXBUF;
+#define UCSWRST     (0x0001)
+#define UCSYNC      (0x0100)
+#define UCOAEN      (0x0400)
+#define UCMODE_3    (0x0600)
+#define UCRXIE0     (0x0001)
+#define UCTXIE0     (0x0002)
+#define UCSTTIE     (0x0004)
+#define UCSTPIE     (0x0008)
+#define USCI_I2C_UCSTTIFG   (0x0006)
+#define USCI_I2C_UCSTPIFG   (0x0008)
+#define USCI_I2C_UCRXIFG0   (0x0016)
+#define USCI_I2C_UCTXIFG0   (0x0018)
+#define USCI_I2C_UCBIT9IFG  (0x001E)
+
+#endif
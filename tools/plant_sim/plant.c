@@ -0,0 +1,374 @@
+#include "sim.h"
+#include "outputs.h"
+#include "igniter.h"
+#include "main_valve.h"
+#include "thermistor.h"
+#include "thermostat.h"
+#include "ignition.h"
+#include "system_state.h"
+#include "sampling.h"
+#include <msp430.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PLANT_STEP_S      0.01       // Plant integration step
+#define ADC_FULL_SCALE    4095.0
+#define ADC_VREF_MV       3300.0
+#define POT_MIN_ADC       100        // Potentiometer.c
+#define KWH_PER_M3        10.55      // Natural gas, gross
+#define LINK_EDGES_MAX    (2 * (THERMOSTAT_FRAME_BITS + 2) + 1)
+
+PlantConfig plant;
+
+extern uint8_t valvePercent;         // main.c
+
+// Plant state
+static double roomC, hxC, sensorC, statC, tcMv;
+static uint8_t pilotLit = 0;
+static uint8_t sparking = 0;
+static uint8_t sparkLights = 0;      // Drawn per spark train
+static double sparkGasS = 0;
+static double mainFraction = 0;
+static uint64_t nextStep = 0;
+static uint64_t endTime = 0;
+static uint64_t rng = 0;
+
+// Thermostat
+static uint8_t calling = 0;
+static double integral = 0;
+static uint64_t nextFrame = 0;
+static uint64_t linkTime[LINK_EDGES_MAX];
+static uint8_t linkLevel[LINK_EDGES_MAX];
+static uint8_t linkCount = 0;
+static uint8_t linkNext = 0;
+
+// Safety trip
+static uint8_t tripStage = 0;        // 0 before, 1 open, 2 closed again
+static uint8_t tripWatch = 0;        // Trip seen, controller not back in IDLE
+static uint8_t tripClosed = 0;
+static double tripReopenS = 0;
+
+// Results
+static double gasKwh, pilotKwh, unburnedKwh, heatKwh, mainHours;
+static uint32_t sparkTrains, pilotLights, burnerStarts;
+static double maxExcursion = 0;
+static double lastOutsideS = 0;
+static double tailSq = 0, tailMin = 1e9, tailMax = -1e9;
+static uint32_t tailCount = 0;
+
+// Trace
+static FILE *trace = 0;
+static uint64_t nextTrace = 0;
+
+// xorshift64*, so runs repeat across hosts
+static double Uniform(void) {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (double)((rng * 2685821657736338717ULL) >> 11) / 9007199254740992.0;
+}
+
+static double Gauss(void) {
+    double u = Uniform();
+    if (u < 1e-12) u = 1e-12;
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * Uniform());
+}
+
+static uint16_t ToCode(double code) {
+    if (code < 0) return 0;
+    if (code > ADC_FULL_SCALE) return (uint16_t)ADC_FULL_SCALE;
+    return (uint16_t)(code + 0.5);
+}
+
+static double Lag(double value, double target, double tauS) {
+    return (tauS > 0) ? value + (target - value) * PLANT_STEP_S / tauS : target;
+}
+
+void Plant_Defaults(PlantConfig *c) {
+    c->hours = 6;
+    c->setpointC = 21;
+    c->roomInitC = 15;
+    c->outdoorC = 0;
+    c->bandK = 1.0;
+    c->seed = 1;
+
+    c->burnerKw = 10;
+    c->pilotKw = 0.25;
+    c->efficiency = 0.85;
+    c->igniteDelayS = 0.8;
+    c->igniteProb = 0.95;
+
+    c->tcLitMv = 500;
+    c->tcColdMv = 25;
+    c->tcHeatTauS = 1.5;
+    c->tcCoolTauS = 3;
+    c->tcNoiseMv = 2;
+
+    c->hxTauS = 90;
+    c->hxUaKw = 0.5;
+    c->roomTauS = 7200;
+    c->roomUaKw = 0.25;
+
+    c->sensorTauS = 30;
+    c->sensorNoiseCodes = 2;
+
+    c->strategy = STRATEGY_ONOFF;
+    c->potPercent = 100;
+    c->diffK = 0.5;
+    c->statTauS = 60;
+    c->kp = 40;
+    c->tiS = 1800;
+    c->modMin = 20;
+    c->frameS = 1;
+
+    c->minBurnS = 120;
+    c->minOffS = 180;
+    c->mergeS = 30;
+    c->pilotHoldS = 0;
+    c->trigger = 1;
+
+    c->tripS = 0;
+    c->tripLenS = 0.05;
+
+    c->traceS = 0;
+}
+
+void Plant_Init(const char *tracePath) {
+    roomC = hxC = sensorC = statC = plant.roomInitC;
+    tcMv = plant.tcColdMv;
+    rng = 0x9E3779B97F4A7C15ULL ^ plant.seed;
+    endTime = SIM_UNITS(plant.hours * 3600);
+    nextStep = SIM_UNITS(PLANT_STEP_S);
+    nextFrame = SIM_UNITS(plant.frameS);
+
+    // Inputs at rest: safety switch closed, heat request line high
+    P2IN |= BIT3;
+    P4IN |= BIT1;
+
+    if (tracePath && plant.traceS > 0) {
+        trace = fopen(tracePath, "w");
+        if (!trace) {
+            perror(tracePath);
+            exit(1);
+        }
+        fprintf(trace, "time_s,setpoint_c,room_c,controller_room_c,hx_c,tc_mv,pilot_lit,valve_pct,state\n");
+    }
+}
+
+// Manchester frame as link edges from the next ACLK tick (thermostat_gen.py)
+static void QueueFrame(uint8_t flags, uint8_t setpoint, uint8_t modulation) {
+    uint8_t bytes[4] = { flags, setpoint, modulation, (uint8_t)~(flags + setpoint + modulation) };
+    uint64_t tick = simNow / SIM_ACLK_UNITS + 1;
+    uint8_t level = 1;
+    uint8_t bit, half, i;
+
+    linkCount = linkNext = 0;
+    for (i = 0; i < THERMOSTAT_FRAME_BITS + 2; i++) {
+        if (i == 0 || i == THERMOSTAT_FRAME_BITS + 1) {
+            bit = 1;                                 // Start and stop bits
+        } else {
+            bit = (bytes[(i - 1) >> 3] >> (7 - ((i - 1) & 7))) & 1;
+        }
+        for (half = 0; half < 2; half++) {
+            uint8_t value = half ? bit : !bit;
+            if (value != level) {
+                level = value;
+                linkTime[linkCount] = tick * SIM_ACLK_UNITS;
+                linkLevel[linkCount++] = level;
+            }
+            tick += THERMOSTAT_HALF_BIT;
+        }
+    }
+    if (level != 1) {
+        linkTime[linkCount] = tick * SIM_ACLK_UNITS;
+        linkLevel[linkCount++] = 1;
+    }
+}
+
+// Thermostat on its own lagged view of the room
+static void Thermostat(void) {
+    if (plant.strategy == STRATEGY_ONOFF) {
+        if (statC < plant.setpointC - plant.diffK / 2) calling = 1;
+        if (statC > plant.setpointC + plant.diffK / 2) calling = 0;
+        Mcu_PinInput(4, BIT1, !calling);            // Active low
+        return;
+    }
+
+    if (simNow < nextFrame) return;
+    nextFrame += SIM_UNITS(plant.frameS);
+
+    // PI with the integral clamped to the output range
+    double error = plant.setpointC - statC;
+    integral += error * plant.frameS / plant.tiS;
+    if (integral < 0) integral = 0;
+    if (integral * plant.kp > 100) integral = 100 / plant.kp;
+    double rate = plant.kp * (error + integral);
+
+    // Below the burner's turndown the call cycles instead
+    if (rate >= plant.modMin) calling = 1;
+    if (rate < plant.modMin / 2) calling = 0;
+    if (rate < plant.modMin) rate = plant.modMin;
+    if (rate > 100) rate = 100;
+
+    QueueFrame(calling ? THERMOSTAT_FLAG_HEAT : 0, (uint8_t)(plant.setpointC * 2 + 0.5),
+               calling ? (uint8_t)(rate + 0.5) : 0);
+}
+
+// Actuators as the controller left them in the registers
+static void Step(void) {
+    uint8_t pilotGas = (P1DIR & P1OUT & PILOT_VALVE_PIN) ? 1 : 0;
+    uint8_t spark = (TB0CTL & MC_3) == MC__UP && (TB0CCTL1 & OUTMOD_7) == OUTMOD_7;
+    uint8_t mainWasLit = pilotLit && mainFraction > 0;
+    double t = SIM_SECONDS(simNow);
+    double heatKw;
+
+    mainFraction = 0;
+    if ((TB1CTL & MC_3) == MC__UP && (TB1CCTL1 & OUTMOD_7) == OUTMOD_7 && TB1CCR1 > MAIN_VALVE_MIN_FLOW) {
+        mainFraction = (double)(TB1CCR1 - MAIN_VALVE_MIN_FLOW) / (MAIN_VALVE_MAX_FLOW - MAIN_VALVE_MIN_FLOW);
+        if (mainFraction > 1) mainFraction = 1;
+    }
+
+    // Pilot lights once gas has reached a sparking igniter
+    if (spark && !sparking) {
+        sparkTrains++;
+        sparkLights = Uniform() < plant.igniteProb;
+        sparkGasS = 0;
+    }
+    sparking = spark;
+    if (!pilotGas) {
+        pilotLit = 0;
+    } else if (spark && sparkLights && !pilotLit) {
+        sparkGasS += PLANT_STEP_S;
+        if (sparkGasS >= plant.igniteDelayS) {
+            pilotLit = 1;
+            pilotLights++;
+        }
+    }
+    if (pilotLit && mainFraction > 0 && !mainWasLit) burnerStarts++;
+
+    // Once a trip has closed the pilot it must stay closed until the
+    // controller is back in IDLE
+    if (tripWatch) {
+        if (!pilotGas) tripClosed = 1;
+        else if (tripClosed) tripReopenS += PLANT_STEP_S;
+        if (tripClosed && (currentState == STATE_IDLE || currentState == STATE_LOCKOUT)) tripWatch = 0;
+    }
+
+    // Gas in, heat through the exchanger into the room
+    double pilotIn = pilotGas ? plant.pilotKw : 0;
+    double mainIn = mainFraction * plant.burnerKw;
+    gasKwh += (pilotIn + mainIn) * PLANT_STEP_S / 3600;
+    pilotKwh += pilotIn * PLANT_STEP_S / 3600;
+    if (!pilotLit) unburnedKwh += (pilotIn + mainIn) * PLANT_STEP_S / 3600;
+    if (mainFraction > 0) mainHours += PLANT_STEP_S / 3600;
+
+    heatKw = pilotLit ? (pilotIn + mainIn) * plant.efficiency : 0;
+    double toRoom = plant.hxUaKw * (hxC - roomC);
+    double toOutside = plant.roomUaKw * (roomC - plant.outdoorC);
+    hxC += (heatKw - toRoom) * PLANT_STEP_S / (plant.hxUaKw * plant.hxTauS);
+    roomC += (toRoom - toOutside) * PLANT_STEP_S / (plant.roomUaKw * plant.roomTauS);
+    heatKwh += toRoom * PLANT_STEP_S / 3600;
+
+    sensorC = Lag(sensorC, roomC, plant.sensorTauS);
+    statC = Lag(statC, roomC, plant.statTauS);
+    double tcTarget = pilotLit ? plant.tcLitMv : plant.tcColdMv;
+    tcMv = Lag(tcMv, tcTarget, tcTarget > tcMv ? plant.tcHeatTauS : plant.tcCoolTauS);
+
+    // Step response against the setpoint
+    double direction = (plant.setpointC >= plant.roomInitC) ? 1 : -1;
+    double excursion = direction * (roomC - plant.setpointC);
+    if (excursion > maxExcursion) maxExcursion = excursion;
+    if (fabs(roomC - plant.setpointC) > plant.bandK) lastOutsideS = t;
+    if (t >= plant.hours * 1800) {
+        tailSq += (roomC - plant.setpointC) * (roomC - plant.setpointC);
+        if (roomC < tailMin) tailMin = roomC;
+        if (roomC > tailMax) tailMax = roomC;
+        tailCount++;
+    }
+
+    if (trace && simNow >= nextTrace) {
+        nextTrace += SIM_UNITS(plant.traceS);
+        fprintf(trace, "%.1f,%.2f,%.3f,%.2f,%.2f,%.1f,%u,%u,%u\n", t, plant.setpointC, roomC,
+                sensorSamples.roomTemp / 100.0, hxC, tcMv, pilotLit, valvePercent, (unsigned)currentState);
+    }
+
+    Thermostat();
+}
+
+uint64_t Plant_Next(void) {
+    if (linkNext < linkCount && linkTime[linkNext] < nextStep) return linkTime[linkNext];
+    return nextStep;
+}
+
+static void Finish(void) {
+    PlantResults r;
+    double settledS = (fabs(roomC - plant.setpointC) <= plant.bandK) ? lastOutsideS : -1;
+
+    r.settlingS = settledS;
+    r.overshootK = maxExcursion;
+    r.tailRmsK = tailCount ? sqrt(tailSq / tailCount) : 0;
+    r.tailSwingK = tailCount ? tailMax - tailMin : 0;
+    r.finalRoomC = roomC;
+    r.gasKwh = gasKwh;
+    r.gasM3 = gasKwh / KWH_PER_M3;
+    r.pilotKwh = pilotKwh;
+    r.unburnedKwh = unburnedKwh;
+    r.heatKwh = heatKwh;
+    r.mainHours = mainHours;
+    r.sparkTrains = sparkTrains;
+    r.pilotLights = pilotLights;
+    r.burnerStarts = burnerStarts;
+    r.controllerIgnitions = ignitionParams.ignitions;
+    r.controllerFailures = ignitionParams.failures;
+    r.linkErrors = thermostatErrors;
+    r.tripReopenS = tripReopenS;
+    r.tripClosed = tripClosed;
+    r.endState = currentState;
+    r.lockoutReason = lockoutReason;
+
+    if (trace) fclose(trace);
+    Sim_Finish(&r);
+}
+
+void Plant_Run(void) {
+    while (linkNext < linkCount && linkTime[linkNext] <= simNow) {
+        Mcu_PinInput(4, BIT1, linkLevel[linkNext++]);
+    }
+    if (simNow >= nextStep) {
+        nextStep += SIM_UNITS(PLANT_STEP_S);
+        if (plant.tripS > 0 && tripStage == 0 && simNow >= SIM_UNITS(plant.tripS)) {
+            tripStage = 1;
+            tripWatch = 1;
+            Mcu_PinInput(2, BIT3, 0);
+        } else if (tripStage == 1 && simNow >= SIM_UNITS(plant.tripS + plant.tripLenS)) {
+            tripStage = 2;
+            Mcu_PinInput(2, BIT3, 1);
+        }
+        Step();
+        if (simNow >= endTime) Finish();
+    }
+}
+
+// Sensor voltages as the ADC would convert them, with noise
+uint16_t Plant_AdcCode(uint8_t channel) {
+    static const uint8_t pgaGain[8] = { 1, 2, 3, 5, 9, 17, 25, 33 };
+    double codesPerMv = ADC_FULL_SCALE / ADC_VREF_MV;
+    double mv, ratio;
+
+    switch (channel) {
+        case 1:     // SAC0 output: thermocouple times the PGA gain
+            if (!(SAC0OA & OAEN)) return 0;
+            mv = (tcMv + plant.tcNoiseMv * Gauss()) * pgaGain[(SAC0PGA >> 4) & 7];
+            return ToCode(mv * codesPerMv);
+        case 3:     // Thermocouple direct
+            return ToCode((tcMv + plant.tcNoiseMv * Gauss()) * codesPerMv);
+        case 4:     // Potentiometer, POT_MIN_ADC at 0%
+            return ToCode(POT_MIN_ADC + plant.potPercent * (ADC_FULL_SCALE - POT_MIN_ADC) / 100);
+        case 5:     // Thermistor above the series resistor (thermistor.c)
+            ratio = exp(THERMISTOR_BETA * (1.0 / (sensorC + 273.15) - 1.0 / 298.15));
+            return ToCode(ADC_FULL_SCALE / (1 + ratio) + plant.sensorNoiseCodes * Gauss());
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,186 @@
+#include "sim.h"
+#include "demand.h"
+#include "sampling.h"
+#include "thermostat.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Closed-loop run of the unmodified controller (main.c and its modules)
+// against the plant model in plant.c:
+//
+//     plant_sim [name=value ...]
+//
+// Parameters are the PlantConfig fields listed below, plus
+// strategy=onoff|modulating, trigger=timer|software, trace=<csv path>
+// and format=text|kv. Simulated time only advances while the controller
+// sleeps, so a day runs in seconds.
+
+int controller_main(void);             // main.c, renamed at build time
+int _system_pre_init(void);            // boot.c, C startup hook
+
+extern uint8_t thermostatMode;         // main.c
+
+typedef struct {
+    const char *name;
+    double *value;
+} Param;
+
+static const Param params[] = {
+    { "hours",          &plant.hours },
+    { "setpoint",       &plant.setpointC },
+    { "room_init",      &plant.roomInitC },
+    { "outdoor",        &plant.outdoorC },
+    { "band",           &plant.bandK },
+    { "burner_kw",      &plant.burnerKw },
+    { "pilot_kw",       &plant.pilotKw },
+    { "efficiency",     &plant.efficiency },
+    { "ignite_delay",   &plant.igniteDelayS },
+    { "ignite_prob",    &plant.igniteProb },
+    { "tc_lit_mv",      &plant.tcLitMv },
+    { "tc_cold_mv",     &plant.tcColdMv },
+    { "tc_heat_tau",    &plant.tcHeatTauS },
+    { "tc_cool_tau",    &plant.tcCoolTauS },
+    { "tc_noise_mv",    &plant.tcNoiseMv },
+    { "hx_tau",         &plant.hxTauS },
+    { "hx_ua",          &plant.hxUaKw },
+    { "room_tau",       &plant.roomTauS },
+    { "room_ua",        &plant.roomUaKw },
+    { "sensor_tau",     &plant.sensorTauS },
+    { "sensor_noise",   &plant.sensorNoiseCodes },
+    { "pot",            &plant.potPercent },
+    { "diff",           &plant.diffK },
+    { "stat_tau",       &plant.statTauS },
+    { "kp",             &plant.kp },
+    { "ti",             &plant.tiS },
+    { "mod_min",        &plant.modMin },
+    { "frame",          &plant.frameS },
+    { "min_burn",       &plant.minBurnS },
+    { "min_off",        &plant.minOffS },
+    { "merge",          &plant.mergeS },
+    { "pilot_hold",     &plant.pilotHoldS },
+    { "trip",           &plant.tripS },
+    { "trip_len",       &plant.tripLenS },
+    { "trace_period",   &plant.traceS },
+};
+
+static const char *stateNames[] = {
+    "IDLE", "PREPURGE", "PILOT_IGNITION", "PILOT_PROVE", "MAIN_VALVE",
+    "SHUTDOWN", "LOCKOUT", "PILOT_HOLD"
+};
+
+static uint8_t keyValue = 0;
+static clock_t started;
+
+static void Usage(const char *arg) {
+    unsigned i;
+
+    fprintf(stderr, "unknown parameter '%s'; known:\n ", arg);
+    for (i = 0; i < sizeof(params) / sizeof(params[0]); i++) fprintf(stderr, " %s", params[i].name);
+    fprintf(stderr, " seed strategy trigger trace format\n");
+    exit(2);
+}
+
+static void Parse(const char *arg, const char **tracePath) {
+    const char *eq = strchr(arg, '=');
+    const char *value;
+    size_t len;
+    unsigned i;
+
+    if (!eq) Usage(arg);
+    len = (size_t)(eq - arg);
+    value = eq + 1;
+
+    if (!strncmp(arg, "strategy", len) && len == 8) {
+        if (!strcmp(value, "onoff")) plant.strategy = STRATEGY_ONOFF;
+        else if (!strcmp(value, "modulating")) plant.strategy = STRATEGY_MODULATING;
+        else Usage(arg);
+    } else if (!strncmp(arg, "trigger", len) && len == 7) {
+        if (!strcmp(value, "timer")) plant.trigger = SAMPLE_TRIGGER_TIMER;
+        else if (!strcmp(value, "software")) plant.trigger = SAMPLE_TRIGGER_SOFTWARE;
+        else Usage(arg);
+    } else if (!strncmp(arg, "trace", len) && len == 5) {
+        *tracePath = value;
+        if (plant.traceS <= 0) plant.traceS = 10;
+    } else if (!strncmp(arg, "format", len) && len == 6) {
+        keyValue = !strcmp(value, "kv");
+    } else if (!strncmp(arg, "seed", len) && len == 4) {
+        plant.seed = (uint32_t)strtoul(value, 0, 0);
+    } else {
+        for (i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+            if (strlen(params[i].name) == len && !strncmp(arg, params[i].name, len)) {
+                *params[i].value = atof(value);
+                return;
+            }
+        }
+        Usage(arg);
+    }
+}
+
+void Sim_Finish(const PlantResults *r) {
+    double wallS = (double)(clock() - started) / CLOCKS_PER_SEC;
+    const char *state = (r->endState < sizeof(stateNames) / sizeof(stateNames[0])) ?
+                        stateNames[r->endState] : "?";
+
+    if (keyValue) {
+        printf("settling_s=%.0f overshoot_k=%.3f tail_rms_k=%.3f tail_swing_k=%.3f final_room_c=%.2f "
+               "gas_kwh=%.3f gas_m3=%.3f pilot_kwh=%.3f unburned_kwh=%.4f heat_kwh=%.3f main_h=%.3f "
+               "spark_trains=%u pilot_lights=%u burner_starts=%u ctrl_ignitions=%u ctrl_failures=%u "
+               "link_errors=%u trip_closed=%u trip_reopen_s=%.2f end_state=%s lockout=%u wall_s=%.2f\n",
+               r->settlingS, r->overshootK, r->tailRmsK, r->tailSwingK, r->finalRoomC,
+               r->gasKwh, r->gasM3, r->pilotKwh, r->unburnedKwh, r->heatKwh, r->mainHours,
+               r->sparkTrains, r->pilotLights, r->burnerStarts, r->controllerIgnitions,
+               r->controllerFailures, r->linkErrors, r->tripClosed, r->tripReopenS, state,
+               r->lockoutReason, wallS);
+    } else {
+        printf("%.1f h, %s thermostat, %.1f -> %.1f degC, outdoor %.1f degC\n", plant.hours,
+               plant.strategy == STRATEGY_ONOFF ? "on/off" : "modulating",
+               plant.roomInitC, plant.setpointC, plant.outdoorC);
+        if (r->settlingS >= 0) {
+            printf("  settling time      %8.1f min  (within +/-%.2f K)\n", r->settlingS / 60, plant.bandK);
+        } else {
+            printf("  settling time      not settled  (ended %.2f degC)\n", r->finalRoomC);
+        }
+        printf("  overshoot          %8.2f K\n", r->overshootK);
+        printf("  2nd half error     %8.2f K rms, %.2f K swing\n", r->tailRmsK, r->tailSwingK);
+        printf("  gas used           %8.2f kWh  (%.3f m3, pilot %.2f kWh, unburned %.3f kWh)\n",
+               r->gasKwh, r->gasM3, r->pilotKwh, r->unburnedKwh);
+        printf("  heat delivered     %8.2f kWh\n", r->heatKwh);
+        printf("  main valve open    %8.2f h\n", r->mainHours);
+        printf("  ignitions          %8u spark trains, %u pilot lights, %u burner starts\n",
+               r->sparkTrains, r->pilotLights, r->burnerStarts);
+        printf("  controller count   %8u ignitions, %u failed trials, ends in %s\n",
+               r->controllerIgnitions, r->controllerFailures, state);
+        if (plant.strategy == STRATEGY_MODULATING) {
+            printf("  link errors        %8u\n", r->linkErrors);
+        }
+        if (plant.tripS > 0) {
+            printf("  safety trip        %s, pilot reopened %.2f s before IDLE\n",
+                   r->tripClosed ? "closed the pilot" : "did NOT close the pilot", r->tripReopenS);
+        }
+        printf("  speed              %8.0fx real time\n", wallS > 0 ? plant.hours * 3600 / wallS : 0);
+    }
+    exit(0);
+}
+
+int main(int argc, char **argv) {
+    const char *tracePath = 0;
+    int i;
+
+    Plant_Defaults(&plant);
+    for (i = 1; i < argc; i++) Parse(argv[i], &tracePath);
+    Plant_Init(tracePath);
+
+    // Controller tuning, as its globals would be set before the loop
+    demandConfig.minBurnMs = (uint32_t)(plant.minBurnS * 1000);
+    demandConfig.minOffMs = (uint32_t)(plant.minOffS * 1000);
+    demandConfig.mergeMs = (uint32_t)(plant.mergeS * 1000);
+    demandConfig.pilotHoldMs = (plant.pilotHoldS < 65.5) ? (uint16_t)(plant.pilotHoldS * 1000) : 65535;
+    sampleTrigger = plant.trigger;
+    thermostatMode = (plant.strategy == STRATEGY_MODULATING) ? THERMOSTAT_DIGITAL : THERMOSTAT_LEVEL;
+
+    started = clock();
+    _system_pre_init();
+    return controller_main();
+}
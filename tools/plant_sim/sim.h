@@ -0,0 +1,121 @@
+#ifndef PLANT_SIM_SIM_H_
+#define PLANT_SIM_SIM_H_
+
+#include <stdint.h>
+
+// Simulated time in 1/512MHz units: whole numbers of ACLK (32768Hz),
+// SMCLK (1MHz) and Timer_B2 (SMCLK/8) periods
+#define SIM_UNITS_PER_SEC  512000000ULL
+#define SIM_ACLK_UNITS     15625ULL
+#define SIM_SMCLK_UNITS    512ULL
+#define SIM_TB2_UNITS      4096ULL
+#define SIM_SECONDS(t)     ((double)(t) / SIM_UNITS_PER_SEC)
+#define SIM_UNITS(s)       ((uint64_t)((s) * SIM_UNITS_PER_SEC))
+
+extern uint64_t simNow;
+
+// Thermostat strategies
+typedef enum {
+    STRATEGY_ONOFF,            // Wall thermostat switching P4.1, rate from the pot
+    STRATEGY_MODULATING        // PI thermostat on the Manchester link (thermostat.h)
+} Strategy;
+
+// Plant, sensor and scenario parameters; see Plant_Defaults()
+typedef struct {
+    // Scenario
+    double hours;              // Simulated duration
+    double setpointC;
+    double roomInitC;
+    double outdoorC;
+    double bandK;              // Settled = within setpoint +/- band
+    uint32_t seed;
+
+    // Burner
+    double burnerKw;           // Main burner input at 100% flow
+    double pilotKw;
+    double efficiency;         // Burned input that reaches the heat exchanger
+    double igniteDelayS;       // Spark with pilot gas until the pilot lights
+    double igniteProb;         // Chance that a spark train lights the pilot
+
+    // Flame thermocouple, at the ADC pin before the SAC gain
+    double tcLitMv;
+    double tcColdMv;
+    double tcHeatTauS;
+    double tcCoolTauS;
+    double tcNoiseMv;
+
+    // Heat exchanger and room, first order each
+    double hxTauS;
+    double hxUaKw;             // kW/K from the heat exchanger to room air
+    double roomTauS;
+    double roomUaKw;           // kW/K from room air to outdoors
+
+    // Room thermistor
+    double sensorTauS;
+    double sensorNoiseCodes;
+
+    // Thermostat and firing rate
+    uint8_t strategy;
+    double potPercent;         // Firing rate with STRATEGY_ONOFF
+    double diffK;              // On/off differential
+    double statTauS;           // Thermostat's own sensing lag
+    double kp;                 // %/K, STRATEGY_MODULATING
+    double tiS;                // Integral time
+    double modMin;             // Lowest rate the thermostat asks for
+    double frameS;             // Frame period on the link
+
+    // Controller tuning (written into the controller before it starts)
+    double minBurnS;
+    double minOffS;
+    double mergeS;
+    double pilotHoldS;
+    uint8_t trigger;           // SampleTrigger
+
+    // Safety switch (P2.3) opened at tripS for tripLenS, 0 = never
+    double tripS;
+    double tripLenS;
+
+    double traceS;             // Trace period, 0 = no trace
+} PlantConfig;
+
+extern PlantConfig plant;
+
+// End of run
+typedef struct {
+    double settlingS;          // Last time outside the band, -1 = ended outside
+    double overshootK;         // Furthest past the setpoint in the step direction
+    double tailRmsK;           // Error over the second half of the run
+    double tailSwingK;         // Room temperature swing over the second half
+    double finalRoomC;
+    double gasKwh;
+    double gasM3;
+    double pilotKwh;
+    double unburnedKwh;        // Gas that flowed with no flame
+    double heatKwh;            // Delivered into the room
+    double mainHours;
+    uint32_t sparkTrains;
+    uint32_t pilotLights;
+    uint32_t burnerStarts;
+    uint16_t controllerIgnitions;
+    uint16_t controllerFailures;
+    uint16_t linkErrors;       // thermostatErrors
+    double tripReopenS;        // Pilot gas after a trip had closed it, before IDLE
+    uint8_t tripClosed;        // The trip closed the pilot
+    uint8_t endState;
+    uint8_t lockoutReason;
+} PlantResults;
+
+// sim.c
+void Sim_Finish(const PlantResults *results);   // Reports and exits
+
+// mcu.c
+void Mcu_PinInput(uint8_t port, uint8_t pin, uint8_t level);
+
+// plant.c: called from the simulated LPM0 loop
+void Plant_Defaults(PlantConfig *config);
+void Plant_Init(const char *tracePath);
+uint64_t Plant_Next(void);                 // Next time the plant needs to run
+void Plant_Run(void);                      // Due steps and link edges at simNow
+uint16_t Plant_AdcCode(uint8_t channel);   // Conversion result for an ADC input
+
+#endif
@@ -0,0 +1,176 @@
+#include "spsc_queue.h"
+#include "events.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Host benchmark and stress test for spsc_queue.c:
+//
+//     queue_bench [items]
+//
+// Throughput: push/pop pairs of Event items, as the firmware uses them.
+// Host numbers only compare queue changes with each other.
+//
+// Ordering: as on the target, the producer is an interrupt. A signal
+// handler pushes a running sequence number into queues of
+// EVENT_QUEUE_SIZE and ADC_QUEUE_SIZE, preempting the consumer loop
+// between instructions, and the consumer checks every item it pops.
+//
+// Exits 1 on a lost, repeated or reordered item.
+
+#define DEFAULT_ITEMS     5000000UL  // Throughput
+#define STRESS_ITEMS      5000UL
+#define INTERRUPT_SPACING 40        // Mean 20 consumer instructions between interrupts
+#define TIMER_PERIOD_NS   20000     // Non-x86 hosts: timer interrupt instead
+
+SPSC_QUEUE_DEFINE(eventTest, Event, EVENT_QUEUE_SIZE);
+SPSC_QUEUE_DEFINE(adcTest, Event, ADC_QUEUE_SIZE);
+
+static double Seconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static Event Pack(uint32_t seq) {
+    Event e;
+
+    e.type = (uint8_t)(seq >> 24);
+    e.arg8 = (uint8_t)(seq >> 16);
+    e.arg16 = (uint16_t)seq;
+    return e;
+}
+
+static uint32_t Unpack(const Event *e) {
+    return ((uint32_t)e->type << 24) | ((uint32_t)e->arg8 << 16) | e->arg16;
+}
+
+// Producer "ISR": runs between two consumer instructions and pushes a
+// burst of 1-7 items, stopping early if the queue is full
+static SpscQueue *volatile isrQueue;
+static volatile uint32_t produced, target, fullHits, interrupts;
+static uint32_t countdown, rng = 1;
+
+static void ProducerIsr(int sig) {
+    Event e;
+    uint8_t burst;
+
+    (void)sig;
+    if (--countdown) return;
+    rng = rng * 1103515245u + 12345u;
+    countdown = 1 + (rng >> 16) % INTERRUPT_SPACING;
+    burst = 1 + (uint8_t)((rng >> 8) % 7);
+
+    interrupts++;
+    while (burst-- && produced < target) {
+        e = Pack(produced);
+        if (!Queue_Push(isrQueue, &e)) {
+            fullHits++;
+            break;
+        }
+        produced++;
+    }
+}
+
+#if defined(__x86_64__)
+// Single-step the consumer (EFLAGS.TF): every instruction traps, and the
+// producer runs at a pseudo-random subset of the traps, so over a run it
+// preempts Queue_Pop() at each of its instruction boundaries
+static void Preempt(uint8_t on) {
+    struct sigaction sa;
+
+    if (on) {
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = ProducerIsr;
+        sigaction(SIGTRAP, &sa, 0);
+        __asm__ volatile("pushfq; orq $0x100, (%%rsp); popfq" ::: "memory", "cc");
+    } else {
+        __asm__ volatile("pushfq; andq $~0x100, (%%rsp); popfq" ::: "memory", "cc");
+    }
+}
+#else
+// Elsewhere a fast timer signal stands in, which preempts at random
+// instructions only
+static timer_t timer;
+
+static void Preempt(uint8_t on) {
+    struct sigaction sa;
+    struct itimerspec period;
+    sigevent_t ev;
+
+    if (!on) {
+        timer_delete(timer);
+        return;
+    }
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = ProducerIsr;
+    sigaction(SIGALRM, &sa, 0);
+    memset(&ev, 0, sizeof(ev));
+    ev.sigev_notify = SIGEV_SIGNAL;
+    ev.sigev_signo = SIGALRM;
+    timer_create(CLOCK_MONOTONIC, &ev, &timer);
+    memset(&period, 0, sizeof(period));
+    period.it_value.tv_nsec = TIMER_PERIOD_NS;
+    period.it_interval.tv_nsec = TIMER_PERIOD_NS;
+    timer_settime(timer, 0, &period, 0);
+}
+#endif
+
+// Returns the number of lost, repeated or reordered items
+static uint32_t Stress(const char *name, SpscQueue *q, uint32_t items) {
+    uint32_t expect = 0, errors = 0;
+    double start = Seconds();
+    Event e;
+
+    q->head = q->tail = (uint16_t)(0 - items / 2);      // Indices wrap mid-run
+    isrQueue = q;
+    produced = fullHits = interrupts = 0;
+    target = items;
+    countdown = 1;
+
+    // Consumer: the main loop, polling as the firmware does
+    Preempt(1);
+    while (expect < items) {
+        if (Queue_Count(q) > q->mask + 1u) errors++;    // Never more than capacity
+        if (!Queue_Pop(q, &e)) continue;
+        if (Unpack(&e) != expect) errors++;
+        expect = Unpack(&e) + 1;                         // Resynchronise after an error
+    }
+    Preempt(0);
+    if (Queue_Pop(q, &e)) errors++;                      // Nothing extra
+
+    printf("stress %-6s capacity %2u  %lu items  %lu interrupts (%lu found it full)  %.1f s  errors %lu\n",
+           name, q->mask + 1u, (unsigned long)items, (unsigned long)interrupts,
+           (unsigned long)fullHits, Seconds() - start, (unsigned long)errors);
+    return errors;
+}
+
+static void Throughput(SpscQueue *q, uint32_t items) {
+    uint32_t i, sum = 0;
+    double start;
+    Event e = Pack(0), out;
+
+    Queue_Flush(q);
+    start = Seconds();
+    for (i = 0; i < items; i++) {
+        e.arg16 = (uint16_t)i;
+        Queue_Push(q, &e);
+        Queue_Pop(q, &out);
+        sum += out.arg16;
+    }
+    printf("single thread push+pop  %.1f M pairs/s  (checksum %lu)\n",
+           items / (Seconds() - start) / 1e6, (unsigned long)sum);
+}
+
+int main(int argc, char **argv) {
+    uint32_t items = (argc > 1) ? (uint32_t)strtoul(argv[1], 0, 0) : DEFAULT_ITEMS;
+    uint32_t errors = 0;
+
+    Throughput(&eventTest, items);
+    errors += Stress("event", &eventTest, STRESS_ITEMS);
+    errors += Stress("adc", &adcTest, STRESS_ITEMS);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""Encode digital thermostat frames (thermostat.h) as link edge timings.
+
+Prints one edge per line as "<time in 32768Hz ticks>,<level after edge>",
+suitable for a pattern generator or for feeding Thermostat_Edge() on the
+host. Frames are separated by --gap-ms of idle-high line.
+
+    thermostat_gen.py --heat 1 --setpoint 42 --modulation 60 [--repeat 3]
+"""
+import argparse
+
+HALF_BIT = 16
+
+
+def frame_bits(flags, setpoint, modulation):
+    check = ~(flags + setpoint + modulation) & 0xFF
+    bits = [1]
+    for byte in (flags, setpoint, modulation, check):
+        bits += [(byte >> i) & 1 for i in range(7, -1, -1)]
+    return bits + [1]
+
+
+def edges(bits, start, jitter=0):
+    """Manchester: each bit is (first half, second half) = (!b, b)."""
+    level = 1                    # Idle high
+    out = []
+    t = start
+    for bit in bits:
+        for half in (1 - bit, bit):
+            if half != level:
+                level = half
+                out.append((t, level))
+            t += HALF_BIT + jitter
+    if level != 1:
+        out.append((t, 1))
+    return out, t
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--heat", type=int, default=1)
+    ap.add_argument("--setpoint", type=int, default=40, help="0.5 degC units")
+    ap.add_argument("--modulation", type=int, default=0, help="percent")
+    ap.add_argument("--repeat", type=int, default=1)
+    ap.add_argument("--gap-ms", type=int, default=1000)
+    ap.add_argument("--jitter", type=int, default=0, help="ticks added per half-bit")
+    args = ap.parse_args()
+
+    bits = frame_bits(args.heat & 1, args.setpoint & 0xFF, args.modulation & 0xFF)
+    t = 0
+    for _ in range(args.repeat):
+        out, t = edges(bits, t, args.jitter)
+        for when, level in out:
+            print(f"{when},{level}")
+        t += args.gap_ms * 32768 // 1000
+
+
+if __name__ == "__main__":
+    main()